@@ -0,0 +1,341 @@
+// BatchEngine.cpp : Random-vs-random games stepped in lockstep over structure-of-arrays boards.
+//
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include "BatchEngine.h"
+#include "FleetSampler.h"
+#include "ThreadPool.h"
+#include "Random.h"
+
+using namespace std;
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_ENGINE_AVX2 1                                             // A second copy of the step built for AVX2, picked at startup
+#define FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define FORCE_INLINE __forceinline
+#else
+#define FORCE_INLINE inline
+#endif
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE,
+    ALL_SHIPS_SUNK = (1 << NUM_SHIPS) - 1,
+    BATCH_GRAIN_SIZE = 16 * BATCH_LANES                                 // Games a thread queues for its batch at a time
+};
+
+struct alignas(64) GameBatch                                            // Side 0 is Player1; masks by side, word, lane
+{
+    int numLanes;                                                       // Live games, in lanes [0, numLanes)
+    int gameIndex[BATCH_LANES];
+    uint64_t random[4][BATCH_LANES];                                    // xoshiro256** state of each game
+    uint64_t occupied[2][BOARD_MASK_WORDS][BATCH_LANES];
+    uint64_t shipMasks[2][NUM_SHIPS][BOARD_MASK_WORDS][BATCH_LANES];
+    uint64_t damage[2][BOARD_MASK_WORDS][BATCH_LANES];                  // Cells of the side's ships that were hit
+    unsigned char sunkFlags[2][BATCH_LANES];
+    unsigned char isOver[BATCH_LANES];
+    int shots[2][BATCH_LANES];
+    unsigned char shotOrder[2][BATCH_LANES][NUM_CELLS];                 // The side's first shots[side] cells are the ones fired at
+};
+
+struct alignas(64) BatchThreadStats                                     // Written by one thread only, merged after the run
+{
+    long long gamesPlayed;
+    long long wins[2];
+    long long totalTurns;
+    int minTurns;
+    int maxTurns;
+};
+
+struct BatchQueue                                                       // Games [next, end) still to be played
+{
+    int next;
+    int end;
+    unsigned int seed;
+};
+
+struct BatchRun
+{
+    unsigned int seed;
+    GameBatch* batches;                                                 // One per pool thread, by threadIndex
+};
+static BatchThreadStats threadStats[MAX_POOL_THREADS];
+
+static void StartLane(GameBatch& batch, int lane, int gameIndex, unsigned int seed)
+{
+    static const struct CellOrder
+    {
+        unsigned char cells[NUM_CELLS];
+
+        CellOrder()
+        {
+            for (int cell = 0; cell < NUM_CELLS; cell++)
+            {
+                cells[cell] = (unsigned char)cell;
+            }
+        }
+    } identity;
+
+    RandomState random;
+
+    SeedRandom(random, uint64_t(seed) + gameIndex);
+
+    for (int side = 0; side < 2; side++)
+    {
+        FleetLayout fleet;
+
+        GenerateRandomFleet(random, fleet);
+
+        for (int w = 0; w < BOARD_MASK_WORDS; w++)
+        {
+            batch.occupied[side][w][lane] = fleet.occupiedMask.bits[w];
+            batch.damage[side][w][lane] = 0;
+
+            for (int s = 0; s < NUM_SHIPS; s++)
+            {
+                batch.shipMasks[side][s][w][lane] = fleet.ships[s].mask.bits[w];
+            }
+        }
+
+        batch.sunkFlags[side][lane] = 0;
+        batch.shots[side][lane] = 0;
+        memcpy(batch.shotOrder[side][lane], identity.cells, NUM_CELLS);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        batch.random[i][lane] = random.s[i];
+    }
+
+    batch.gameIndex[lane] = gameIndex;
+    batch.isOver[lane] = 0;
+}
+
+static void MoveLane(GameBatch& batch, int from, int to)
+{
+    for (int side = 0; side < 2; side++)
+    {
+        for (int w = 0; w < BOARD_MASK_WORDS; w++)
+        {
+            batch.occupied[side][w][to] = batch.occupied[side][w][from];
+            batch.damage[side][w][to] = batch.damage[side][w][from];
+
+            for (int s = 0; s < NUM_SHIPS; s++)
+            {
+                batch.shipMasks[side][s][w][to] = batch.shipMasks[side][s][w][from];
+            }
+        }
+
+        batch.sunkFlags[side][to] = batch.sunkFlags[side][from];
+        batch.shots[side][to] = batch.shots[side][from];
+        memcpy(batch.shotOrder[side][to], batch.shotOrder[side][from], NUM_CELLS);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        batch.random[i][to] = batch.random[i][from];
+    }
+
+    batch.gameIndex[to] = batch.gameIndex[from];
+    batch.isOver[to] = batch.isOver[from];
+}
+
+static inline uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/*
+    One shot by side in every lane whose game is still going: draw, pick the cell, apply it to the
+    other side's fleet, then redo the sunk flags and the game over test for every lane. Apart from
+    the shot order swap every loop is branch-free and independent across lanes; with SSE2 the
+    compiler vectorizes the generator, with AVX2 also the hit test, which needs per-lane shifts.
+*/
+static FORCE_INLINE void StepSideLanes(GameBatch& batch, int side)
+{
+    int target = 1 - side;
+    int numLanes = batch.numLanes;
+    uint32_t draws[BATCH_LANES];
+    unsigned char cells[BATCH_LANES];
+
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        uint64_t s0 = batch.random[0][lane];
+        uint64_t s1 = batch.random[1][lane];
+        uint64_t s2 = batch.random[2][lane] ^ s0;
+        uint64_t s3 = batch.random[3][lane] ^ s1;
+        draws[lane] = uint32_t(RotateLeft(s1 * 5, 7) * 9 >> 32);
+        batch.random[0][lane] = s0 ^ s3;
+        batch.random[1][lane] = s1 ^ s2;
+        batch.random[2][lane] = s2 ^ (s1 << 17);
+        batch.random[3][lane] = RotateLeft(s3, 45);
+    }
+
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        unsigned char* order = batch.shotOrder[side][lane];
+        int shot = batch.shots[side][lane];
+        int pick = shot + int((uint64_t(draws[lane]) * uint32_t(NUM_CELLS - shot)) >> 32);
+        unsigned char cell = order[pick];
+        order[pick] = order[shot];
+        order[shot] = cell;
+        cells[lane] = cell;
+        batch.shots[side][lane] = shot + (batch.isOver[lane] ^ 1);
+    }
+
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        uint64_t isLive = uint64_t(batch.isOver[lane]) - 1;
+        uint64_t cell = cells[lane];
+        uint64_t low = (uint64_t(1) << (cell & 63)) & (uint64_t(0) - (cell < 64)) & isLive;
+        uint64_t high = (uint64_t(1) << (cell & 63)) & (uint64_t(0) - (cell >= 64)) & isLive;
+        batch.damage[target][0][lane] |= low & batch.occupied[target][0][lane];
+        batch.damage[target][1][lane] |= high & batch.occupied[target][1][lane];
+    }
+
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        unsigned int flags = 0;
+        for (int s = 0; s < NUM_SHIPS; s++)
+        {
+            uint64_t afloat = (batch.shipMasks[target][s][0][lane] & ~batch.damage[target][0][lane]) | (batch.shipMasks[target][s][1][lane] & ~batch.damage[target][1][lane]);
+            flags |= unsigned(afloat == 0) << s;
+        }
+        batch.sunkFlags[target][lane] = (unsigned char)flags;
+        batch.isOver[lane] |= (unsigned char)(flags == ALL_SHIPS_SUNK);
+    }
+}
+
+static void StepSideGeneric(GameBatch& batch, int side)
+{
+    StepSideLanes(batch, side);
+}
+
+#ifdef BATCH_ENGINE_AVX2
+__attribute__((target("avx2"))) static void StepSideAVX2(GameBatch& batch, int side)
+{
+    StepSideLanes(batch, side);
+}
+
+static void (*const StepSide)(GameBatch& batch, int side) = __builtin_cpu_supports("avx2") ? StepSideAVX2 : StepSideGeneric;
+#else
+static void (*const StepSide)(GameBatch& batch, int side) = StepSideGeneric;
+#endif
+
+/*
+    Finished games leave: their lane gets the next queued game, or once the queue is empty the last
+    live lane, which is then looked at again in its new place.
+*/
+static void RetireGames(GameBatch& batch, BatchQueue& queue, BatchThreadStats& stats)
+{
+    for (int lane = 0; lane < batch.numLanes;)
+    {
+        if (!batch.isOver[lane])
+        {
+            lane++;
+            continue;
+        }
+
+        int turns = batch.shots[0][lane] + batch.shots[1][lane];
+        int winner = batch.sunkFlags[1][lane] == ALL_SHIPS_SUNK ? 0 : 1;
+
+        stats.gamesPlayed++;
+        stats.wins[winner]++;
+        stats.totalTurns += turns;
+        stats.minTurns = turns < stats.minTurns ? turns : stats.minTurns;
+        stats.maxTurns = turns > stats.maxTurns ? turns : stats.maxTurns;
+
+        if (queue.next < queue.end)
+        {
+            StartLane(batch, lane, queue.next++, queue.seed);
+            lane++;
+        }
+        else if (lane < --batch.numLanes)
+        {
+            MoveLane(batch, batch.numLanes, lane);
+        }
+    }
+}
+
+static void PlayBatchGames(int threadIndex, int begin, int end, void* context)
+{
+    const BatchRun& run = *(const BatchRun*)context;
+    GameBatch& batch = run.batches[threadIndex];
+    BatchQueue queue = { begin, end, run.seed };
+
+    batch.numLanes = 0;
+
+    while (batch.numLanes < BATCH_LANES && queue.next < queue.end)
+    {
+        StartLane(batch, batch.numLanes++, queue.next++, queue.seed);
+    }
+
+    while (batch.numLanes > 0)
+    {
+        StepSide(batch, 0);
+        StepSide(batch, 1);
+        RetireGames(batch, queue, threadStats[threadIndex]);
+    }
+}
+
+void RunBatchGames(int numGames, unsigned int seed, int numThreads, BatchReport& report)
+{
+    SetThreadPoolSize(numThreads);
+    numThreads = GetThreadPoolSize();
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        memset(&threadStats[t], 0, sizeof(threadStats[t]));
+        threadStats[t].minTurns = 2 * NUM_CELLS;
+    }
+
+    unique_ptr<unsigned char[]> memory(new unsigned char[sizeof(GameBatch) * numThreads + alignof(GameBatch)]);   // 120 KB a thread, for this run only
+    uintptr_t address = uintptr_t(memory.get());
+    BatchRun run = { seed, (GameBatch*)(address + (alignof(GameBatch) - address % alignof(GameBatch)) % alignof(GameBatch)) };
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    ParallelFor(numGames, BATCH_GRAIN_SIZE, PlayBatchGames, &run);
+
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report.numThreads = numThreads;
+    report.gamesPlayed = 0;
+    report.wins[0] = 0;
+    report.wins[1] = 0;
+    report.totalTurns = 0;
+    report.minTurns = 2 * NUM_CELLS;
+    report.maxTurns = 0;
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        const BatchThreadStats& stats = threadStats[t];
+
+        report.gamesPlayed += stats.gamesPlayed;
+        report.wins[0] += stats.wins[0];
+        report.wins[1] += stats.wins[1];
+        report.totalTurns += stats.totalTurns;
+        report.minTurns = stats.minTurns < report.minTurns ? stats.minTurns : report.minTurns;
+        report.maxTurns = stats.maxTurns > report.maxTurns ? stats.maxTurns : report.maxTurns;
+    }
+}
+
+void PrintBatchReport(const BatchReport& report)
+{
+    if (report.gamesPlayed == 0)
+    {
+        cout << "No games were played." << endl;
+        return;
+    }
+
+    double games = double(report.gamesPlayed);
+
+    cout << "Games played:   " << report.gamesPlayed << " in batches of " << BATCH_LANES << " on " << report.numThreads << " thread(s)" << endl;
+    cout << "Player1 wins:   " << report.wins[0] << " (" << 100.0 * report.wins[0] / games << "%)" << endl;
+    cout << "Player2 wins:   " << report.wins[1] << " (" << 100.0 * report.wins[1] / games << "%)" << endl;
+    cout << "Turns per game: avg " << report.totalTurns / games << ", min " << report.minTurns << ", max " << report.maxTurns << endl;
+    cout << "Elapsed:        " << report.elapsedSeconds << " s (" << games / report.elapsedSeconds << " games/sec, " << report.totalTurns / report.elapsedSeconds << " shots/sec)" << endl;
+}
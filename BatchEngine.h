@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef __BATCHENGINE_H__
+#define __BATCHENGINE_H__
+
+#include <cstdint>
+#include "Game.h"
+
+/*
+    Random-vs-random games in lockstep. A batch holds up to BATCH_LANES games with every field
+    stored structure-of-arrays: all games' Player1 fleet masks are one array, their damage masks
+    another, and so on. A round has Player1 fire in every game, then Player2 in every game that is
+    still going, and each half runs as plain loops over the lanes: the random draws, the hit test
+    and damage update, the per-ship sunk checks and the game over test, which the compiler turns
+    into vector code.
+
+    Shots are drawn from a per-lane shuffled shot order, extended by one Fisher-Yates step per
+    shot, so every shot is a uniform pick among the cells not fired at yet and none is wasted. The
+    swap is the one part that stays scalar.
+
+    Finished games leave between rounds. While the queue of games lasts, the next game is set up
+    in the freed lane; once it is empty, the last live lane moves into the gap, so the loops always
+    run over a dense prefix. Game i is seeded with seed + i, so the totals do not depend on the
+    batch size or the number of threads.
+*/
+
+enum
+{
+    BATCH_LANES = 256
+};
+
+struct BatchReport
+{
+    int numThreads;
+    long long gamesPlayed;
+    long long wins[2];
+    long long totalTurns;                                               // Every turn is one shot
+    int minTurns;
+    int maxTurns;
+    double elapsedSeconds;
+};
+
+void RunBatchGames(int numGames, unsigned int seed, int numThreads, BatchReport& report);
+void PrintBatchReport(const BatchReport& report);
+
+#endif
@@ -6,113 +6,94 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <csignal>
 #include "Utils.h"
+#include "Game.h"
+#include "Simulation.h"
+#include "Tournament.h"
+#include "BoardGame.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include "PlacementKernel.h"
+#include "Renderer.h"
+#include "Terminal.h"
+#include "MonteCarloAI.h"
+#include "EndgameSolver.h"
+#include "GameLog.h"
+#include "GameAnalytics.h"
+#include "Snapshot.h"
+#include "Replay.h"
+#include "Strategy.h"
+#include "Profiler.h"
+#include "Referee.h"
+#include "Bot.h"
+#include "Server.h"
+#include "BatchEngine.h"
 
 using namespace std;
 
 const char* INPUT_ERROR_STRING = "Input Error! Please try again. ";
 
-/* Enums */
+FrameBuffer screenFrame;                                                // The board as it is on screen, DrawBoards only sends what changed
+const char* autosavePath = nullptr;                                     // Snapshot file rewritten after every turn of the console game, null for none
+GameServer* runningServer = nullptr;                                    // Stopped by SIGINT/SIGTERM in --server mode
 
-enum                                                                    // Anonymous enum to define constant values 
+struct CommandLineOptions                                               // Settings picked on the command line, defaults give the interactive game
 {
-    AIRCRAFT_CARRIER_SIZE = 5,
-    BATTLESHIP_SIZE = 4,
-    CRUISER_SIZE = 3,
-    DESTROYER_SIZE = 3,
-    SUBMARINE_SIZE = 2,
-
-    BOARD_SIZE = 10,
-    NUM_SHIPS = 5,
-    PLAYER_NAME_SIZE = 8,                                               // Player1, Player2
-    MAX_SHIP_SIZE = AIRCRAFT_CARRIER_SIZE
-};
- 
-enum ShipType                                                           // Type of ship enum to simplify shiptypes to a number
-{
-    ST_NONE = 0,
-    ST_AIRCRAFT_CARRIER,
-    ST_BATTLESHIP,
-    ST_CRUISER,
-    ST_DESTROYER,
-    ST_SUBMARINE
-};
-            
-enum ShipOrientationType                                                 // Orientation enum to define horizontal and vertical direction of ships 
-{
-    SO_HORIZONTAL = 0,
-    SO_VERTICAL
-};
-
-enum GuessType                                                           // Type of guess the player makes, only three types
-{
-    GT_NONE = 0,
-    GT_MISSED,
-    GT_HIT
-};
-
-enum PlayerType
-{
-    PT_HUMAN = 0,
-    PT_AI
-};
-
-/* Structs */
-
-struct ShipPositionType                                                 // The position coordinates of the ship on the board
-{
-    int row;
-    int col;
-};
-
-struct ShipPartType                                                     // The board spot state
-{
-    ShipType shipType;
-    bool isHit;
-};
-
-struct Ship                                                             // Ship struct defining ship data 
-{
-    ShipType shipType;
-    int shipSize;
-    ShipOrientationType shipOrientation;
-    ShipPositionType shipPosition;
-};
-
-struct Player                                                           // Player struct defining player data
-{
-    PlayerType playerType;
-    char playerName[PLAYER_NAME_SIZE];
-    Ship ships[NUM_SHIPS];
-    GuessType guessBoard[BOARD_SIZE][BOARD_SIZE];
-    ShipPartType shipBoard[BOARD_SIZE][BOARD_SIZE];
+    int simulateGames;                                                  // > 0 runs that many headless AI-vs-AI games instead
+    int tournamentGames;                                                // > 0 runs that many headless games over all threads
+    int batchGames;                                                     // > 0 runs that many random-vs-random games in lockstep batches
+    int numThreads;
+    GameVariantType variant;                                            // Board and fleet for --tournament
+    TerminalModeType terminalMode;
+    AIStrategyType strategies[2];                                       // Player1/Player2 in headless games, Player2 is also the console AI
+    unsigned int seed;
+    bool isSeedGiven;                                                   // --seed was passed, the run is meant to be repeatable
+    double monteCarloBudget;                                            // --mc-budget in ms, 0 if not given
+    int monteCarloSamples;                                              // --mc-samples, 0 if not given
+    const char* recordPath;                                             // Binary log of the headless games, null for none
+    const char* analyzePath;                                            // Game log to summarize instead of playing
+    const char* savePath;                                               // Autosave file for the console game
+    const char* resumePath;                                             // Snapshot to continue the console game from
+    const char* replayPath;                                             // Game log to replay a game from instead of playing
+    long long replayGame;                                               // Index of the game to replay, from 0
+    int replayTurn;                                                     // Turn to show, -1 for the end of the game
+    bool showStats;                                                     // Print the phase timings on the way out
+    int refereeGames;                                                   // > 0 referees that many games between two external engines
+    const char* engineCommands[2];                                      // Shell commands that start engine A and engine B
+    int moveMilliseconds;                                               // Time limit on every engine or client answer, 0 for the mode's default
+    int serverPort;                                                     // > 0 serves games on that TCP port
+    int serverTestClients;                                              // > 0 runs a loopback server and that many clients against it
+    int sessionGames;                                                   // Games each --server-test client plays
+    int maxSessions;
+    bool isBot;                                                         // Play the engine side of the protocol on stdin/stdout
+    AIStrategyType botStrategy;
 };
 
-/* Initializations for player and ships */
+/* Command line functions */
 
-void InitializePlayer(Player& player, const char* playerName);          // Initialize the player function
-void InitializeShip(Ship& ship, int shipSize, ShipType shipType);       // Initialize the ship function
+bool ParseCommandLine(int argc, char* argv[], CommandLineOptions& options);
+bool RunServerMode(const CommandLineOptions& options);                  // --server until interrupted, or --server-test over loopback
+void StopRunningServer(int signal);
+void PrintUsage(const char* programName);
 
 /* Game functions */
 
 void PlayGame(Player& player1, Player& player2);                        // Play game function
+void PlayTurns(Player& player1, Player& player2, int current, int turn);   // Plays from the given turn to the end, current is 0 for player1
+bool ReplayGame(const CommandLineOptions& options);
 bool WantToPlayAgain();                                                 // Play again function
-ShipType UpdateBoards(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer);
-bool IsGameOver(const Player& player1, const Player& player2);
-bool AreAllShipsSunk(const Player& player);
-bool IsSunk(const Player& player, const Ship& ship);
-void SwitchPlayers(Player** currentPlayer, Player** otherPlayer);
 void DisplayWinner(const Player& player1, const Player& player2);
 PlayerType GetPlayer2Type();
-ShipPositionType GetAIGuess(const Player& aiPlayer);
-ShipPositionType GetRandomPosition();
 
 /* Board functions */
 
 void SetupBoards(Player& player);                                       // Seting up the game boards function (for ship and guess boards)
-void ClearBoards(Player& player);                                       // Clear boards for starting new games
 void DrawBoards(const Player& player);                                  // Draw the game board in the terminal
-void SetupAIBoards(Player& player);
+void DrawBoardsFrame(const Player& player);                             // Both boards into screenFrame, without showing them
 
 /* Drawing of the board functions */
 
@@ -120,6 +101,8 @@ void DrawSeparatorLine();                                               // Creat
 void DrawColumnsRow();                                                  // Creates columns for the game board, including the number of column
 void DrawShipBoardRow(const Player& player, int row);                   // Creates the row for the ship board, starting with 'A'
 void DrawGuessBoardRow(const Player& player, int row);                  // Creates the row for the guessing board, starting with 'A'
+void DrawHeatmap(const char* title, const long long counts[], long long total);   // Prints a board of per mille values below the current output
+void DrawHeatmapRow(const long long counts[], long long total, int row);
 
 /* Drawing of square functions for the boards */
 
@@ -128,17 +111,135 @@ char GetGuessRepresentationAt(const Player& player, int row, int col);  // Creat
 
 /* Placement of ship functions */
 
-const char* GetShipNameForShipType(ShipType shipType);
-ShipPositionType GetBoardPosition();
-ShipPositionType MapBoardPosition(char rowInput, int colInput);
+ShipPositionType GetBoardPosition();                                    // "B7" on one line, or the row and column on two
+ShipPositionType GetShipPlacement(ShipOrientationType& orientation);    // "B7 H", the orientation is asked for if left out
 ShipOrientationType GetShipOrientation();
-bool IsValidPlacement(const Player& player, const Ship& currentShip, const ShipPositionType shipPosition, ShipOrientationType orientation);
-void PlaceShipOnBoard(Player& player, Ship& currentShip, const ShipPositionType shipPosition, const ShipOrientationType orientation);
 
 
-int main()
+int main(int argc, char* argv[])
 {
-    srand(time(NULL));
+    CommandLineOptions options;
+
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    SetThreadPoolSize(options.numThreads);                              // Monte Carlo sampling uses the pool outside tournaments
+
+    if (options.showStats)
+    {
+        atexit(PrintProfileStats);                                      // Whichever way main returns
+    }
+
+    if (options.isBot)
+    {
+        return RunBot(options.botStrategy, options.seed);
+    }
+
+    if (options.refereeGames > 0)
+    {
+        RefereeReport report;
+        bool isComplete = RunReferee(options.refereeGames, options.engineCommands, options.moveMilliseconds > 0 ? options.moveMilliseconds : 1000, report);
+
+        PrintRefereeReport(report);
+        return isComplete ? 0 : 1;
+    }
+
+    if (options.serverPort > 0 || options.serverTestClients > 0)
+    {
+        return RunServerMode(options) ? 0 : 1;
+    }
+
+    if (options.analyzePath != nullptr)
+    {
+        GameLogSummary summary;
+
+        if (!AnalyzeGameLog(options.analyzePath, summary))
+        {
+            cout << options.analyzePath << " is not a readable game log" << endl;
+            return 1;
+        }
+
+        PrintGameLogSummary(summary);
+
+        long long firstHits = 0;
+
+        for (int cell = 0; cell < BOARD_SIZE * BOARD_SIZE; cell++)
+        {
+            firstHits += summary.firstHits[cell];
+        }
+
+        DrawHeatmap("First hit of each player, per mille by cell", summary.firstHits, firstHits);
+        return 0;
+    }
+
+    if (options.replayPath != nullptr)
+    {
+        return ReplayGame(options) ? 0 : 1;
+    }
+
+    static GameLogFile gameLog;
+    GameLogFile* log = nullptr;
+
+    if (options.recordPath != nullptr && (options.simulateGames > 0 || options.tournamentGames > 0))
+    {
+        if (!CreateGameLog(gameLog, options.recordPath))
+        {
+            cout << "Could not create " << options.recordPath << endl;
+            return 1;
+        }
+
+        log = &gameLog;
+    }
+
+    if (options.simulateGames > 0)
+    {
+        SimulationStats stats;
+
+        RunSimulations(options.simulateGames, options.strategies[0], options.strategies[1], options.seed, log, stats);
+        PrintSimulationStats(stats);
+        PrintMonteCarloStats();
+        PrintEndgameStats();
+
+        if (!CloseGameLog(gameLog))                                     // Also false if a block could not be written during the run
+        {
+            cout << "Could not write " << options.recordPath << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (options.tournamentGames > 0)
+    {
+        TournamentReport report;
+
+        RunTournament(options.tournamentGames, options.variant, options.strategies[0], options.strategies[1], options.seed, options.numThreads, log, report);
+        PrintTournamentReport(report);
+        PrintMonteCarloStats();
+        PrintEndgameStats();
+
+        if (!CloseGameLog(gameLog))                                     // Also false if a block could not be written during the run
+        {
+            cout << "Could not write " << options.recordPath << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (options.batchGames > 0)
+    {
+        BatchReport report;
+
+        RunBatchGames(options.batchGames, options.seed, options.numThreads, report);
+        PrintBatchReport(report);
+        return 0;
+    }
+
+    SeedThreadRandom(options.seed);
+    SetTerminalMode(options.terminalMode);
+    InitializeFrame(screenFrame);
     
     Player player1;
     Player player2;
@@ -146,6 +247,31 @@ int main()
     InitializePlayer(player1, "Player1");
     InitializePlayer(player2, "Player2");
 
+    player2.aiStrategy = options.strategies[1];
+
+    autosavePath = options.savePath;
+
+    if (options.resumePath != nullptr)
+    {
+        GameSnapshot snapshot;
+
+        if (!LoadSnapshot(snapshot, options.resumePath))
+        {
+            cout << options.resumePath << " is not a snapshot saved by this build" << endl;
+            return 1;
+        }
+
+        RestoreSnapshot(snapshot, player1, player2);
+
+        ClearScreen();
+        PlayTurns(player1, player2, snapshot.currentPlayer, snapshot.turn);
+
+        if (!WantToPlayAgain())
+        {
+            return 0;
+        }
+    }
+
     do
     {
         PlayGame(player1, player2);
@@ -154,11 +280,350 @@ int main()
     return 0;
 }
 
+/* Command Line Functions */
+
+bool ParseCommandLine(int argc, char* argv[], CommandLineOptions& options)
+{
+    options.simulateGames = 0;
+    options.tournamentGames = 0;
+    options.batchGames = 0;
+    options.numThreads = GetHardwareThreadCount();
+    options.variant = GV_CLASSIC;
+    options.terminalMode = TM_AUTO;
+    options.strategies[0] = AI_RANDOM;
+    options.strategies[1] = AI_RANDOM;
+    options.seed = (unsigned int)time(NULL);
+    options.isSeedGiven = false;
+    options.monteCarloBudget = 0;
+    options.monteCarloSamples = 0;
+    options.recordPath = nullptr;
+    options.analyzePath = nullptr;
+    options.savePath = nullptr;
+    options.resumePath = nullptr;
+    options.replayPath = nullptr;
+    options.replayGame = 0;
+    options.replayTurn = -1;
+    options.showStats = false;
+    options.refereeGames = 0;
+    options.engineCommands[0] = nullptr;
+    options.engineCommands[1] = nullptr;
+    options.moveMilliseconds = 0;
+    options.serverPort = 0;
+    options.serverTestClients = 0;
+    options.sessionGames = 10;
+    options.maxSessions = 10000;
+    options.isBot = false;
+    options.botStrategy = AI_RANDOM;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "--simulate") == 0 && hasValue)
+        {
+            options.simulateGames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--tournament") == 0 && hasValue)
+        {
+            options.tournamentGames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--batch") == 0 && hasValue)
+        {
+            options.batchGames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            options.numThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--variant") == 0 && hasValue)
+        {
+            if (!ParseGameVariant(argv[++i], options.variant))
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--strategy-a") == 0 && hasValue)
+        {
+            if (!ParseAIStrategy(argv[++i], options.strategies[0]))
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--strategy-b") == 0 && hasValue)
+        {
+            if (!ParseAIStrategy(argv[++i], options.strategies[1]))
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--mc-budget") == 0 && hasValue)
+        {
+            options.monteCarloBudget = atof(argv[++i]);
+
+            if (options.monteCarloBudget <= 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--mc-samples") == 0 && hasValue)
+        {
+            options.monteCarloSamples = atoi(argv[++i]);
+
+            if (options.monteCarloSamples <= 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--kernel") == 0 && hasValue)
+        {
+            const char* name = argv[++i];
+            bool selected = false;
+
+            for (int k = PK_AUTO; k <= PK_AVX2 && !selected; k++)
+            {
+                selected = strcmp(name, GetPlacementKernelName(PlacementKernelType(k))) == 0 && SetPlacementKernel(PlacementKernelType(k));
+            }
+
+            if (!selected)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--terminal") == 0 && hasValue)
+        {
+            if (!ParseTerminalMode(argv[++i], options.terminalMode))
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--record") == 0 && hasValue)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--analyze") == 0 && hasValue)
+        {
+            options.analyzePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save") == 0 && hasValue)
+        {
+            options.savePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--resume") == 0 && hasValue)
+        {
+            options.resumePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && hasValue)
+        {
+            options.replayPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--game") == 0 && hasValue)
+        {
+            options.replayGame = atoll(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--turn") == 0 && hasValue)
+        {
+            options.replayTurn = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--stats") == 0)
+        {
+            options.showStats = true;
+        }
+        else if (strcmp(argv[i], "--referee") == 0 && hasValue)
+        {
+            options.refereeGames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--engine-a") == 0 && hasValue)
+        {
+            options.engineCommands[0] = argv[++i];
+        }
+        else if (strcmp(argv[i], "--engine-b") == 0 && hasValue)
+        {
+            options.engineCommands[1] = argv[++i];
+        }
+        else if (strcmp(argv[i], "--move-time") == 0 && hasValue)
+        {
+            options.moveMilliseconds = atoi(argv[++i]);
+
+            if (options.moveMilliseconds <= 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--server") == 0 && hasValue)
+        {
+            options.serverPort = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--server-test") == 0 && hasValue)
+        {
+            options.serverTestClients = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--session-games") == 0 && hasValue)
+        {
+            options.sessionGames = atoi(argv[++i]);
+
+            if (options.sessionGames <= 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--max-sessions") == 0 && hasValue)
+        {
+            options.maxSessions = atoi(argv[++i]);
+
+            if (options.maxSessions <= 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--bot") == 0 && hasValue)
+        {
+            options.isBot = true;
+
+            if (!ParseAIStrategy(argv[++i], options.botStrategy))
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+            options.isSeedGiven = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (options.refereeGames > 0 && (options.engineCommands[0] == nullptr || options.engineCommands[1] == nullptr))
+    {
+        return false;
+    }
+    if (options.monteCarloBudget > 0 && options.monteCarloSamples > 0)
+    {
+        return false;                                                   // One budget or the other
+    }
+    if (options.monteCarloBudget > 0)
+    {
+        SetMonteCarloBudget(options.monteCarloBudget);
+    }
+    else if (options.monteCarloSamples > 0)
+    {
+        SetMonteCarloSamples(options.monteCarloSamples);
+    }
+    else if (options.isSeedGiven || options.recordPath != nullptr)
+    {
+        SetMonteCarloSamples(DEFAULT_MONTE_CARLO_SAMPLES);              // A time budget would make the games depend on the machine
+    }
+    if (options.variant != GV_CLASSIC && (options.strategies[0] != AI_RANDOM || options.strategies[1] != AI_RANDOM))
+    {
+        return false;                                                   // The other boards have no AI strategies, only random fire
+    }
+    return options.recordPath == nullptr || options.variant == GV_CLASSIC;  // The log format only holds classic games
+}
+
+void PrintUsage(const char* programName)
+{
+    cout << "Usage: " << programName << " [options]" << endl;
+    cout << "  (no options)     play the interactive console game" << endl;
+    cout << "  --simulate N     play N headless AI-vs-AI games and print the totals" << endl;
+    cout << "  --tournament N   play N headless games spread over all threads" << endl;
+    cout << "  --batch N        play N random-vs-random games in lockstep batches over all threads" << endl;
+    cout << "  --threads T      worker threads for --tournament and --batch (default: all cores)" << endl;
+    cout << "  --variant V      board for --tournament: classic (10x10), or quick (8x8) and large (20x20), which are random-vs-random only" << endl;
+    cout << "  --strategy-a A   AI for Player1 in headless games (random, density, montecarlo, endgame, parity)" << endl;
+    cout << "  --strategy-b B   AI for Player2, also used for the console AI opponent" << endl;
+    cout << "  --mc-budget MS   sampling time per move for the montecarlo AI (default 1, runs with --seed or --record use --mc-samples)" << endl;
+    cout << "  --mc-samples N   fixed samples per move instead, repeatable from the seed (default " << DEFAULT_MONTE_CARLO_SAMPLES << " with --seed or --record)" << endl;
+    cout << "  --kernel K       placement heatmap kernel: auto, scalar, sse2, avx2" << endl;
+    cout << "  --terminal M     screen handling: auto, ansi, system (cls/pause), plain" << endl;
+    cout << "  --record FILE    write every --simulate/--tournament game to a binary game log" << endl;
+    cout << "  --analyze FILE   print win rates, shot counts, sink order and a first-hit heatmap from a game log" << endl;
+    cout << "  --save FILE      snapshot the console game to FILE after every turn" << endl;
+    cout << "  --resume FILE    continue a console game from a snapshot saved with --save" << endl;
+    cout << "  --replay FILE    replay a game from a game log without playing it, see --game and --turn" << endl;
+    cout << "  --game N         game of the log to replay, from 0 (default 0)" << endl;
+    cout << "  --turn K         show the replayed game after K shots (default: the end)" << endl;
+    cout << "  --stats          print count, total, p50 and p99 per game phase on exit (profiling builds)" << endl;
+    cout << "  --referee N      referee N games between two external engines, see Referee.h for the protocol" << endl;
+    cout << "  --engine-a CMD   shell command that starts engine A for --referee" << endl;
+    cout << "  --engine-b CMD   shell command that starts engine B" << endl;
+    cout << "  --move-time MS   time limit on each engine or client answer (default 1000, 60000 for --server)" << endl;
+    cout << "  --server PORT    serve games against the --strategy-b AI over TCP, same protocol as --referee, until interrupted" << endl;
+    cout << "  --max-sessions N concurrent --server sessions (default 10000)" << endl;
+    cout << "  --server-test N  run a loopback server and N concurrent --strategy-a clients against it" << endl;
+    cout << "  --session-games G games each --server-test client plays (default 10)" << endl;
+    cout << "  --bot S          act as an engine for --referee, playing the built-in AI S" << endl;
+    cout << "  --seed S         seed for the random number generator" << endl;
+}
+
+bool RunServerMode(const CommandLineOptions& options)
+{
+    static GameServer server;
+    ServerConfig config;
+
+    config.port = options.serverPort;
+    config.isLoopbackOnly = options.serverPort == 0;                    // The self-test picks a free loopback port
+    config.maxSessions = options.maxSessions;
+    config.moveMilliseconds = options.moveMilliseconds > 0 ? options.moveMilliseconds : (options.serverPort > 0 ? 60000 : 1000);
+    config.strategy = options.strategies[1];
+    config.seed = options.seed;
+
+    if (options.serverTestClients > 0 && config.maxSessions < options.serverTestClients)
+    {
+        config.maxSessions = options.serverTestClients;
+    }
+
+    if (!StartServer(server, config))
+    {
+        cout << "Could not listen on port " << config.port << endl;
+        return false;
+    }
+
+    if (options.serverTestClients == 0)
+    {
+        cout << "Serving games on port " << server.port << ", Ctrl+C to stop" << endl;
+
+        runningServer = &server;
+        signal(SIGINT, StopRunningServer);
+        signal(SIGTERM, StopRunningServer);
+
+        RunServer(server);
+        CloseServer(server);
+        PrintServerStats(server.stats);
+        return true;
+    }
+
+    LoadTestReport report;
+    thread serverThread(RunServer, ref(server));
+    bool isComplete = RunServerLoadTest(server.port, options.serverTestClients, options.sessionGames, options.strategies[0], options.seed + 1, report);
+
+    StopServer(server);
+    serverThread.join();
+    CloseServer(server);
+
+    PrintLoadTestReport(report);
+    cout << endl << "Server (" << GetAIStrategyName(config.strategy) << ")" << endl;
+    PrintServerStats(server.stats);
+
+    return isComplete && report.gamesPlayed == server.stats.gamesPlayed;  // Both ends have to agree on every game
+}
+
+void StopRunningServer(int)
+{
+    if (runningServer != nullptr)
+    {
+        StopServer(*runningServer);
+    }
+}
+
+/* End of Command Line Functions */
+
 /* Game Functions */
 
 void PlayGame(Player& player1, Player& player2)
 {
     ClearScreen();
+    InvalidateFrame(screenFrame);
 
     player1.playerType = PT_HUMAN;
     player2.playerType = GetPlayer2Type();
@@ -166,12 +631,19 @@ void PlayGame(Player& player1, Player& player2)
     SetupBoards(player1);
     SetupBoards(player2);
 
-    Player* currentPlayer = &player1;
-    Player* otherPlayer = &player2;
+    PlayTurns(player1, player2, 0, 0);
+}
+
+void PlayTurns(Player& player1, Player& player2, int current, int turn)
+{
+    InvalidateFrame(screenFrame);
+
+    Player* currentPlayer = current == 0 ? &player1 : &player2;
+    Player* otherPlayer = current == 0 ? &player2 : &player1;
 
     ShipPositionType guess;
 
-    do
+    while (!IsGameOver(player1, player2))                               // A resumed snapshot may be of a finished game
     {
         if (currentPlayer->playerType == PT_HUMAN)
         {
@@ -179,29 +651,47 @@ void PlayGame(Player& player1, Player& player2)
         }
 
         bool isValidGuess;
+        int retries = -1;
 
-        do
         {
-            if (currentPlayer->playerType == PT_HUMAN)
-            {
-                cout << currentPlayer->playerName << " what is your guess? " << endl;
+            PROFILE_SCOPE(PP_GUESS_LOOP);
 
-                guess = GetBoardPosition();
-            }
-            else
+            do
             {
-                guess = GetAIGuess(*currentPlayer);
-            }
-            isValidGuess = currentPlayer->guessBoard[guess.row][guess.col] == GT_NONE;
+                if (currentPlayer->playerType == PT_HUMAN)
+                {
+                    cout << currentPlayer->playerName << " what is your guess? " << endl;
 
-            if (!isValidGuess && currentPlayer->playerType == PT_HUMAN)
-            {
-                cout << "That was not a valid guess! Please try again." << endl;
-            }
+                    PROFILE_SCOPE(PP_INPUT_WAIT);
+
+                    guess = GetBoardPosition();
+                }
+                else
+                {
+                    PROFILE_SCOPE(PP_AI_GUESS);
+
+                    guess = GetAIGuess(*currentPlayer);
+                }
+                isValidGuess = GetGuessAt(*currentPlayer, guess.row, guess.col) == GT_NONE;
+                retries++;
 
-        } while (!isValidGuess);
+                if (!isValidGuess && currentPlayer->playerType == PT_HUMAN)
+                {
+                    cout << "That was not a valid guess! Please try again." << endl;
+                }
 
-        ShipType type = UpdateBoards(guess, *currentPlayer, *otherPlayer);
+            } while (!isValidGuess);
+        }
+
+        PROFILE_VALUE(PP_GUESS_RETRIES, retries);
+
+        ShipType type;
+
+        {
+            PROFILE_SCOPE(PP_UPDATE_BOARDS);
+
+            type = UpdateBoards(guess, *currentPlayer, *otherPlayer);
+        }
 
         if (currentPlayer->playerType == PT_AI)
         {
@@ -224,10 +714,24 @@ void PlayGame(Player& player1, Player& player2)
             }
         }
 
-        WaitForKeyPress();
+        {
+            PROFILE_SCOPE(PP_INPUT_WAIT);
+
+            WaitForKeyPress();
+        }
+
         SwitchPlayers(&currentPlayer, &otherPlayer);
 
-    } while (!IsGameOver(player1, player2));
+        turn++;
+
+        if (autosavePath != nullptr)
+        {
+            GameSnapshot snapshot;
+
+            TakeSnapshot(snapshot, player1, player2, turn, currentPlayer == &player1 ? 0 : 1);
+            SaveSnapshot(snapshot, autosavePath);
+        }
+    }
 
     DisplayWinner(player1, player2);
 }
@@ -243,55 +747,6 @@ bool WantToPlayAgain()
     return input == 'y';
 }
 
-bool IsGameOver(const Player& player1, const Player& player2)
-{
-    return AreAllShipsSunk(player1) || AreAllShipsSunk(player2);
-}
-
-bool AreAllShipsSunk(const Player& player)
-{
-    for (int i = 0; i < NUM_SHIPS; i++)
-    {
-        if (!IsSunk(player, player.ships[i]))
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool IsSunk(const Player& player, const Ship& ship)
-{
-    if (ship.shipOrientation == SO_HORIZONTAL)
-    {
-        for (int col = ship.shipPosition.col; col < (ship.shipPosition.col + ship.shipSize); col++)
-        {
-            if (!player.shipBoard[ship.shipPosition.row][col].isHit)
-            {
-                return false;
-            }
-        }
-    }
-    else
-    {
-        for (int row = ship.shipPosition.row; row < (ship.shipPosition.row + ship.shipSize); row++)
-        {
-            if (!player.shipBoard[row][ship.shipPosition.col].isHit)
-            {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
-void SwitchPlayers(Player** currentPlayer, Player** otherPlayer)
-{
-    Player* temp = *currentPlayer;
-    *currentPlayer = *otherPlayer;
-    *otherPlayer = temp;
-}
-
 PlayerType GetPlayer2Type()
 {
     const int validInputs[2] = { 1, 2 };
@@ -320,19 +775,66 @@ void DisplayWinner(const Player& player1, const Player& player2)
     }
 }
 
-ShipPositionType GetRandomPosition()
+bool ReplayGame(const CommandLineOptions& options)
 {
-    ShipPositionType guess;
+    MappedFile log;
+    GameRecordView record;
 
-    guess.row = rand() % BOARD_SIZE;
-    guess.col = rand() % BOARD_SIZE;
+    if (!MapFile(options.replayPath, log))
+    {
+        cout << options.replayPath << " is not a readable game log" << endl;
+        return false;
+    }
+    if (!FindGameRecord(log, options.replayGame, record))
+    {
+        cout << options.replayPath << " has no game " << options.replayGame << ", or it is damaged" << endl;
+        UnmapFile(log);
+        return false;
+    }
 
-    return guess;
-}
+    static ReplayTimeline timeline;                                     // About 40 snapshots, too big for the stack
+    GameSnapshot snapshot;
+    int numShots = GetRecordShotCount(record);
+    int turn = options.replayTurn >= 0 && options.replayTurn < numShots ? options.replayTurn : numShots;
 
-ShipPositionType GetAIGuess(const Player& aiPlayer)
-{
-    return GetRandomPosition();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    BuildReplayTimeline(record, timeline);
+
+    chrono::steady_clock::time_point built = chrono::steady_clock::now();
+
+    SeekReplay(timeline, turn, snapshot);
+
+    chrono::steady_clock::time_point sought = chrono::steady_clock::now();
+
+    InitializeFrame(screenFrame);
+
+    for (int p = 0; p < 2; p++)
+    {
+        const Player& player = snapshot.players[p];
+
+        cout << endl << player.playerName << " (" << GetAIStrategyName(player.aiStrategy) << "): ships left, shots fired" << endl;
+        DrawBoardsFrame(player);
+        PrintFrame(screenFrame);
+    }
+
+    cout << endl << "Game " << options.replayGame << ", seed " << GetRecordSeed(record) << ", turn " << turn << " of " << numShots << endl;
+
+    if (turn > 0)
+    {
+        int cell = GetRecordShotCell(record, turn - 1);
+
+        cout << snapshot.players[(turn - 1) & 1].playerName << " last chose row " << char(cell / BOARD_SIZE + 'A') << " and column " << cell % BOARD_SIZE + 1 << (IsRecordShotHit(record, turn - 1) ? ", a hit" : ", a miss") << endl;
+    }
+    if (turn == numShots)
+    {
+        cout << snapshot.players[GetRecordWinner(record)].playerName << " won" << endl;
+    }
+
+    cout << "Replayed " << numShots << " shots in " << chrono::duration<double, micro>(built - start).count() << " us, seek to turn " << turn << " in " << chrono::duration<double, micro>(sought - built).count() << " us" << endl;
+
+    UnmapFile(log);
+    return true;
 }
 
 /* End Game Functions */
@@ -341,12 +843,13 @@ ShipPositionType GetAIGuess(const Player& aiPlayer)
 
 void SetupBoards(Player& player)
 {
+    PROFILE_SCOPE(PP_SETUP_BOARDS);
 
     ClearBoards(player);
 
     if (player.playerType == PT_AI)
     {
-        SetupAIBoards(player);
+        GetStrategy(player.aiStrategy).PlaceFleet(player);
         return;
     }
 
@@ -365,8 +868,7 @@ void SetupBoards(Player& player)
         {
             cout << player.playerName << " please set the potision and orientation for your " << GetShipNameForShipType(currentShip.shipType) << endl;
 
-            shipPosition = GetBoardPosition();
-            orientation = GetShipOrientation();
+            shipPosition = GetShipPlacement(orientation);
 
             isValidPlacement = IsValidPlacement(player, currentShip, shipPosition, orientation);
 
@@ -387,117 +889,80 @@ void SetupBoards(Player& player)
 
 }
 
-void ClearBoards(Player& player)
+void DrawBoards(const Player& player)
 {
-    for (int r = 0; r < BOARD_SIZE; r++)
-    {
-        for (int c = 0; c < BOARD_SIZE; c++)
-        {
-            player.guessBoard[r][c] = GT_NONE;
-            player.shipBoard[r][c].shipType = ST_NONE;
-            player.shipBoard[r][c].isHit = false;
-        }
-    }
+    PROFILE_SCOPE(PP_DRAW_BOARDS);
+
+    DrawBoardsFrame(player);
+
+    PresentFrame(screenFrame);                                          // One write, only the cells that changed
 }
 
-void DrawBoards(const Player& player)
+void DrawBoardsFrame(const Player& player)
 {
-    ClearScreen();
+    BeginFrame(screenFrame);
 
     DrawColumnsRow();
 
     DrawColumnsRow();
 
-    cout << endl;
+    FrameWrite(screenFrame, "\n");
 
     for (int r = 0; r < BOARD_SIZE; r++)
     {
         DrawSeparatorLine();
 
-        cout << " ";
+        FrameWrite(screenFrame, " ");
 
         DrawSeparatorLine();
 
-        cout << endl;
+        FrameWrite(screenFrame, "\n");
 
         DrawShipBoardRow(player, r);
 
-        cout << " ";
+        FrameWrite(screenFrame, " ");
 
         DrawGuessBoardRow(player, r);
 
-        cout << endl;
+        FrameWrite(screenFrame, "\n");
     }
 
     DrawSeparatorLine();
 
-    cout << " ";
+    FrameWrite(screenFrame, " ");
 
     DrawSeparatorLine();
 
-    cout << endl;
+    FrameWrite(screenFrame, "\n");
 }
 
 
-ShipType UpdateBoards(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer)
-{
-    if (otherPlayer.shipBoard[guess.row][guess.col].shipType != ST_NONE)
-    {
-        currentPlayer.guessBoard[guess.row][guess.col] = GT_HIT;
-        otherPlayer.shipBoard[guess.row][guess.col].isHit = true;
-    }
-    else
-    {
-        currentPlayer.guessBoard[guess.row][guess.col] = GT_MISSED;
-    }
-
-    return otherPlayer.shipBoard[guess.row][guess.col].shipType;
-}
-
-void SetupAIBoards(Player& player)
-{
-    ShipPositionType pos;
-    ShipOrientationType orientation;
-
-    for (int i = 0; i < NUM_SHIPS; i++)
-    {
-        Ship& currentShip = player.ships[i];
-
-        do
-        {
-            pos = GetRandomPosition();
-            orientation = ShipOrientationType(rand() % 2);
-
-        } while (!IsValidPlacement(player, currentShip, pos, orientation));
-
-        PlaceShipOnBoard(player, currentShip, pos, orientation);
-    }
-}
-
 /* End of Board Functions */
 
 /* Drawing Board Functions */
 
 void DrawSeparatorLine()
 {
-    cout << " ";
+    FrameWrite(screenFrame, " ");
 
     for (int c = 0; c < BOARD_SIZE; c++)
     {
-        cout << "+---";
+        FrameWrite(screenFrame, "+---");
     }
 
-    cout << "+";
+    FrameWrite(screenFrame, "+");
 }
 
 void DrawColumnsRow()
 {
-    cout << "  ";
+    FrameWrite(screenFrame, "  ");
     for (int c = 0; c < BOARD_SIZE; c++)
     {
         int columnName = c + 1;
 
-        cout << " " << columnName << "  ";
+        FrameWrite(screenFrame, " ");
+        FrameWriteInt(screenFrame, columnName);
+        FrameWrite(screenFrame, "  ");
     }
 }
 
@@ -505,11 +970,14 @@ void DrawShipBoardRow(const Player& player, int row)
 {
     char rowName = row + 'A';                                           // Setting row name variable to the letter, first row is 'A', then adding 1 to it each time it's called.
 
-    cout << rowName << "|";
+    FrameWriteChar(screenFrame, rowName);
+    FrameWrite(screenFrame, "|");
 
     for (int c = 0; c < BOARD_SIZE; c++)
     {
-        cout << " " << GetShipRepresentationAt(player, row, c) << " |";
+        FrameWrite(screenFrame, " ");
+        FrameWriteChar(screenFrame, GetShipRepresentationAt(player, row, c));
+        FrameWrite(screenFrame, " |");
     }
 }
 
@@ -517,11 +985,62 @@ void DrawGuessBoardRow(const Player& player, int row)
 {
     char rowName = row + 'A';                                         // Setting row name variable to the letter, first row is 'A', then adding 1 to it each time it's called.  
 
-    cout << rowName << "|";
+    FrameWriteChar(screenFrame, rowName);
+    FrameWrite(screenFrame, "|");
+
+    for (int c = 0; c < BOARD_SIZE; c++)
+    {
+        FrameWrite(screenFrame, " ");
+        FrameWriteChar(screenFrame, GetGuessRepresentationAt(player, row, c)); // Grab ship representation for guess board
+        FrameWrite(screenFrame, " |");
+    }
+}
+
+void DrawHeatmap(const char* title, const long long counts[], long long total)
+{
+    BeginFrame(screenFrame);
+
+    FrameWrite(screenFrame, title);
+    FrameWrite(screenFrame, "\n");
+
+    DrawColumnsRow();
+
+    FrameWrite(screenFrame, "\n");
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        DrawSeparatorLine();
+
+        FrameWrite(screenFrame, "\n");
+
+        DrawHeatmapRow(counts, total, r);
+
+        FrameWrite(screenFrame, "\n");
+    }
+
+    DrawSeparatorLine();
+
+    FrameWrite(screenFrame, "\n");
+
+    cout << endl;
+    PrintFrame(screenFrame);                                            // A report, so no clearing or diffing
+}
+
+void DrawHeatmapRow(const long long counts[], long long total, int row)
+{
+    char rowName = row + 'A';
+
+    FrameWriteChar(screenFrame, rowName);
+    FrameWrite(screenFrame, "|");
 
     for (int c = 0; c < BOARD_SIZE; c++)
     {
-        cout << " " << GetGuessRepresentationAt(player, row, c) << " |"; // Grab ship representation for guess board
+        char value[8];
+        long long perMille = total > 0 ? (counts[row * BOARD_SIZE + c] * 1000 + total / 2) / total : 0;
+
+        snprintf(value, sizeof(value), "%3d", int(perMille < 999 ? perMille : 999));   // Three characters, like " X " on the boards
+        FrameWrite(screenFrame, value);
+        FrameWrite(screenFrame, "|");
     }
 }
 
@@ -533,27 +1052,30 @@ void DrawGuessBoardRow(const Player& player, int row)
 
 char GetShipRepresentationAt(const Player& player, int row, int col)      // NOTE: Could have used a switch statement here, consider changing in future
 {
-    if (player.shipBoard[row][col].isHit)
+    if (IsShipPartHitAt(player, row, col))
     {
         return '*';                                                     // represents a hit
     }
-    if (player.shipBoard[row][col].shipType == ST_AIRCRAFT_CARRIER)
+
+    ShipType shipType = GetShipTypeAt(player, row, col);
+
+    if (shipType == ST_AIRCRAFT_CARRIER)
     {
         return 'A';
     }
-    else if (player.shipBoard[row][col].shipType == ST_BATTLESHIP)
+    else if (shipType == ST_BATTLESHIP)
     {
         return 'B';
     }
-    else if (player.shipBoard[row][col].shipType == ST_CRUISER)
+    else if (shipType == ST_CRUISER)
     {
         return 'C';
     }
-    else if (player.shipBoard[row][col].shipType == ST_DESTROYER)
+    else if (shipType == ST_DESTROYER)
     {
         return 'D';
     }
-    else if (player.shipBoard[row][col].shipType == ST_SUBMARINE)
+    else if (shipType == ST_SUBMARINE)
     {
         return 'S';
     }
@@ -565,11 +1087,13 @@ char GetShipRepresentationAt(const Player& player, int row, int col)      // NOT
 
 char GetGuessRepresentationAt(const Player& player, int row, int col)
 {
-    if (player.guessBoard[row][col] == GT_HIT)
+    GuessType guess = GetGuessAt(player, row, col);
+
+    if (guess == GT_HIT)
     {
         return '*';
     }
-    else if(player.guessBoard[row][col] == GT_MISSED)
+    else if(guess == GT_MISSED)
     {
         return 'o';
     }
@@ -581,57 +1105,32 @@ char GetGuessRepresentationAt(const Player& player, int row, int col)
 
 /* End of Drawing of Squares Functions */
 
-const char* GetShipNameForShipType(ShipType shipType)
-{
-    if (shipType == ST_AIRCRAFT_CARRIER)
-    {
-        return "Aircraft Carrier";
-    }
-    else if(shipType == ST_BATTLESHIP)
-    {
-        return "Battleship";
-    }
-    else if(shipType == ST_CRUISER)
-    {
-        return "Cruiser";
-    }
-    else if (shipType == ST_DESTROYER)
-    {
-        return "Destroyer";
-    }
-    else if (shipType == ST_SUBMARINE)
-    {
-        return "Submarine";
-    }
-
-    return "None";
-}
-
-ShipPositionType MapBoardPosition(char rowInput, int colInput)
+ShipPositionType GetBoardPosition()
 {
-    int realRow = rowInput - 'A';
-    int realCol = colInput - 1;
+    MoveInput move;
+    char prompt[48];
 
-    ShipPositionType boardPosition;
+    snprintf(prompt, sizeof(prompt), "Please input a position (A1 - %c%d): ", char('A' + BOARD_SIZE - 1), BOARD_SIZE);   // Built from BOARD_SIZE so other board sizes prompt correctly
 
-    boardPosition.row = realRow;
-    boardPosition.col = realCol;
+    GetMove(prompt, INPUT_ERROR_STRING, BOARD_SIZE, BOARD_SIZE, false, move);
 
-    return boardPosition;
+    return MapBoardPosition(char('A' + move.row), move.col + 1);
 }
 
-ShipPositionType GetBoardPosition()
+ShipPositionType GetShipPlacement(ShipOrientationType& orientation)
 {
-    char rowInput;
-    int colInput;
+    MoveInput move;
 
-    const char validRowInputs[] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J' };
-    const int validColumnInputs[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    if (GetMove("Please input a position and orientation (e.g. B7 H): ", INPUT_ERROR_STRING, BOARD_SIZE, BOARD_SIZE, true, move))
+    {
+        orientation = move.orientation == 'H' ? SO_HORIZONTAL : SO_VERTICAL;
+    }
+    else
+    {
+        orientation = GetShipOrientation();                             // Only the cell was given
+    }
 
-    rowInput = GetCharacter("Please input a row(A - J): ", INPUT_ERROR_STRING, validRowInputs, BOARD_SIZE, CC_UPPER_CASE);
-    colInput = GetInteger("Please input a col(1-10)", INPUT_ERROR_STRING, validColumnInputs, BOARD_SIZE);
-    
-    return MapBoardPosition(rowInput, colInput);
+    return MapBoardPosition(char('A' + move.row), move.col + 1);
 }
 
 ShipOrientationType GetShipOrientation()
@@ -651,81 +1150,6 @@ ShipOrientationType GetShipOrientation()
     }
 }
 
-bool IsValidPlacement(const Player& player, const Ship& currentShip, const ShipPositionType shipPosition, ShipOrientationType orientation)
-{
-
-    if (orientation == SO_HORIZONTAL)
-    {
-        for (int c = shipPosition.col; c < (shipPosition.col + currentShip.shipSize); c++)
-        {
-            if (player.shipBoard[shipPosition.row][c].shipType != ST_NONE || c >= BOARD_SIZE)
-            {
-                return false;
-            }
-        }
-    }
-    else {
-        for (int r = shipPosition.row; r < (shipPosition.row + currentShip.shipSize); r++)
-        {
-            if (player.shipBoard[r][shipPosition.col].shipType != ST_NONE || r >= BOARD_SIZE)
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
-}
-
-void PlaceShipOnBoard(Player& player, Ship& currentShip, const ShipPositionType shipPosition, const ShipOrientationType orientation)
-{
-    currentShip.shipPosition = shipPosition;
-    currentShip.shipOrientation = orientation;
-
-    if (orientation == SO_HORIZONTAL)
-    {
-        for (int c = shipPosition.col; c < (shipPosition.col + currentShip.shipSize); c++)
-        {
-            player.shipBoard[shipPosition.row][c].shipType = currentShip.shipType;
-            player.shipBoard[shipPosition.row][c].isHit = false;
-        }
-    }
-    else
-    {
-        for (int r = shipPosition.row; r < (shipPosition.row + currentShip.shipSize); r++)
-        {
-            player.shipBoard[r][shipPosition.col].shipType = currentShip.shipType;
-            player.shipBoard[r][shipPosition.col].isHit = false;
-        }
-    }
-}
-
-/* Player/Ship Initializations functions */
-
-void InitializePlayer(Player& player, const char* playerName)
-{
-    if (playerName != nullptr && strlen(playerName) > 0)
-    {
-        strcpy_s(player.playerName, playerName);
-    }
-
-    InitializeShip(player.ships[0], AIRCRAFT_CARRIER_SIZE, ST_AIRCRAFT_CARRIER);
-    InitializeShip(player.ships[1], BATTLESHIP_SIZE, ST_BATTLESHIP);
-    InitializeShip(player.ships[2], CRUISER_SIZE, ST_CRUISER);
-    InitializeShip(player.ships[3], DESTROYER_SIZE, ST_DESTROYER);
-    InitializeShip(player.ships[4], SUBMARINE_SIZE, ST_SUBMARINE);
-
-}
-
-void InitializeShip(Ship& ship, int shipSize, ShipType shipType)
-{
-    ship.shipType = shipType;
-    ship.shipSize =shipSize;
-    ship.shipPosition.row = 0;
-    ship.shipPosition.col = 0;
-    ship.shipOrientation = SO_HORIZONTAL;
-}
-
 /*
 
 SetupBoards(player)
@@ -865,4 +1289,4 @@ return true;
 
 
 
-*/
\ No newline at end of file
+*/
\ No newline at end of file
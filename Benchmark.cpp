@@ -0,0 +1,718 @@
+// Benchmark.cpp : Micro-benchmarks of the board functions and whole headless games.
+//
+
+/*
+    Each benchmark runs its body state.iterations times. The runner starts with one iteration and
+    grows the count until a run takes at least the minimum time, then reports the time per
+    iteration and, for benchmarks that count items (shots, games), items per second. Work that
+    should not be timed goes between PauseTiming and ResumeTiming.
+
+    Benchmarks that depend on the board layout run once per backend, named .../array and
+    .../bitboard, so the two can be compared line by line. --json writes the results in the same
+    layout Google Benchmark uses, so existing tooling can track them across releases.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "Simulation.h"
+#include "Random.h"
+#include "FleetSampler.h"
+#include "PlacementKernel.h"
+#include "ThreadPool.h"
+#include "Input.h"
+#include "SessionPool.h"
+
+using namespace std;
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE,
+    NUM_FLEETS = 64,                                                    // Precomputed fleets the benchmarks cycle through
+    MAX_BENCHMARK_ITERATIONS = 1000000000
+};
+
+struct BenchmarkState
+{
+    long long iterations;
+    BoardBackendType backend;
+    AIStrategyType strategy;
+    long long items;                                                    // Shots, games... counted by the benchmark, 0 if it has none
+    chrono::steady_clock::duration pausedTime;
+    chrono::steady_clock::time_point pauseStart;
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+struct Benchmark
+{
+    const char* name;
+    BenchmarkFunction function;
+    BoardBackendType backend;
+    AIStrategyType strategy;
+    PlacementKernelType kernel;                                         // PK_AUTO unless the benchmark is about one kernel
+};
+
+struct BenchmarkResult
+{
+    string name;
+    long long iterations;
+    double nanosecondsPerIteration;
+    double itemsPerSecond;                                              // 0 if the benchmark counts no items
+};
+
+struct BenchmarkOptions
+{
+    const char* filter;                                                 // Only benchmarks whose name contains this, null for all
+    const char* jsonPath;
+    double minSeconds;
+    unsigned int seed;
+};
+
+static volatile int benchmarkSink;                                      // Results go here so the compiler cannot drop the work
+
+static FleetLayout fleets[NUM_FLEETS];
+static unsigned char shotOrders[NUM_FLEETS][NUM_CELLS];                 // Random permutations of the cells
+
+/* Timing */
+
+static void PauseTiming(BenchmarkState& state)
+{
+    state.pauseStart = chrono::steady_clock::now();
+}
+
+static void ResumeTiming(BenchmarkState& state)
+{
+    state.pausedTime += chrono::steady_clock::now() - state.pauseStart;
+}
+
+/* Fixtures */
+
+static void PrepareFixtures(unsigned int seed)
+{
+    RandomState random;
+
+    SeedRandom(random, seed);
+
+    for (int i = 0; i < NUM_FLEETS; i++)
+    {
+        GenerateRandomFleet(random, fleets[i]);
+
+        for (int cell = 0; cell < NUM_CELLS; cell++)
+        {
+            shotOrders[i][cell] = (unsigned char)cell;
+        }
+        for (int cell = NUM_CELLS - 1; cell > 0; cell--)
+        {
+            int other = RandomInt(random, cell + 1);
+            unsigned char temp = shotOrders[i][cell];
+
+            shotOrders[i][cell] = shotOrders[i][other];
+            shotOrders[i][other] = temp;
+        }
+    }
+}
+
+static void SetupPlayer(Player& player, const char* name, BoardBackendType backend, AIStrategyType strategy)
+{
+    InitializePlayer(player, name);
+
+    player.playerType = PT_AI;
+    player.aiStrategy = strategy;
+    player.boardBackend = backend;
+
+    ClearBoards(player);
+}
+
+static void PlaceFleet(Player& player, const FleetLayout& fleet)
+{
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        ShipPositionType position;
+
+        position.row = fleet.ships[i].row;
+        position.col = fleet.ships[i].col;
+
+        PlaceShipOnBoard(player, player.ships[i], position, ShipOrientationType(fleet.ships[i].orientation));
+    }
+}
+
+static ShipPositionType CellPosition(int cell)
+{
+    ShipPositionType position;
+
+    position.row = cell / BOARD_SIZE;
+    position.col = cell % BOARD_SIZE;
+
+    return position;
+}
+
+static void PlayShots(Player& shooter, Player& target, const unsigned char shotOrder[], int numShots)
+{
+    for (int i = 0; i < numShots; i++)
+    {
+        UpdateBoards(CellPosition(shotOrder[i]), shooter, target);
+    }
+}
+
+/* Benchmarks */
+
+static void BenchIsValidPlacement(BenchmarkState& state)
+{
+    Player player;
+    int valid = 0;
+
+    SetupPlayer(player, "Player1", state.backend, AI_RANDOM);
+    PlaceFleet(player, fleets[0]);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        int cell = shotOrders[1][i % NUM_CELLS];
+
+        valid += IsValidPlacement(player, player.ships[i % NUM_SHIPS], CellPosition(cell), ShipOrientationType(i & 1));
+    }
+
+    benchmarkSink = valid;
+}
+
+static void BenchPlaceShipOnBoard(BenchmarkState& state)
+{
+    Player player;
+
+    SetupPlayer(player, "Player1", state.backend, AI_RANDOM);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        const ShipPlacement& placement = fleets[(i / NUM_SHIPS) % NUM_FLEETS].ships[i % NUM_SHIPS];
+        ShipPositionType position;
+
+        position.row = placement.row;
+        position.col = placement.col;
+
+        PlaceShipOnBoard(player, player.ships[i % NUM_SHIPS], position, ShipOrientationType(placement.orientation));
+    }
+
+    benchmarkSink = player.ships[0].shipPosition.row;
+}
+
+static void BenchUpdateBoards(BenchmarkState& state)
+{
+    Player players[2];
+    int fleet = 0;
+    int shot = NUM_CELLS;
+    int hits = 0;
+
+    SetupPlayer(players[0], "Player1", state.backend, state.strategy);
+    SetupPlayer(players[1], "Player2", state.backend, state.strategy);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        if (shot == NUM_CELLS)                                          // Every cell guessed, start again on a fresh board
+        {
+            PauseTiming(state);
+
+            fleet = (fleet + 1) % NUM_FLEETS;
+            shot = 0;
+
+            ClearBoards(players[0]);
+            ClearBoards(players[1]);
+            PlaceFleet(players[1], fleets[fleet]);
+
+            ResumeTiming(state);
+        }
+
+        hits += UpdateBoards(CellPosition(shotOrders[fleet][shot++]), players[0], players[1]) != ST_NONE;
+    }
+
+    state.items = state.iterations;
+    benchmarkSink = hits;
+}
+
+static void BenchIsSunk(BenchmarkState& state)
+{
+    Player players[2];
+    int sunk = 0;
+
+    SetupPlayer(players[0], "Player1", state.backend, AI_RANDOM);
+    SetupPlayer(players[1], "Player2", state.backend, AI_RANDOM);
+    PlaceFleet(players[1], fleets[0]);
+    PlayShots(players[0], players[1], shotOrders[0], NUM_CELLS / 2);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        sunk += IsSunk(players[1], players[1].ships[i % NUM_SHIPS]);
+    }
+
+    benchmarkSink = sunk;
+}
+
+static void BenchIsSunkScan(BenchmarkState& state)
+{
+    Player players[2];
+    int sunk = 0;
+
+    SetupPlayer(players[0], "Player1", state.backend, AI_RANDOM);
+    SetupPlayer(players[1], "Player2", state.backend, AI_RANDOM);
+    PlaceFleet(players[1], fleets[0]);
+    PlayShots(players[0], players[1], shotOrders[0], NUM_CELLS / 2);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        sunk += IsSunkScan(players[1], players[1].ships[i % NUM_SHIPS]);
+    }
+
+    benchmarkSink = sunk;
+}
+
+static void BenchAreAllShipsSunk(BenchmarkState& state)
+{
+    Player players[2];
+    int sunk = 0;
+
+    SetupPlayer(players[0], "Player1", state.backend, AI_RANDOM);
+    SetupPlayer(players[1], "Player2", state.backend, AI_RANDOM);
+    PlaceFleet(players[1], fleets[0]);
+    PlayShots(players[0], players[1], shotOrders[0], NUM_CELLS - 1);    // Leaves at most one ship afloat, the worst case for a scan
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        sunk += AreAllShipsSunk(players[1]);
+    }
+
+    benchmarkSink = sunk;
+}
+
+static void BenchAreAllShipsSunkScan(BenchmarkState& state)
+{
+    Player players[2];
+    int sunk = 0;
+
+    SetupPlayer(players[0], "Player1", state.backend, AI_RANDOM);
+    SetupPlayer(players[1], "Player2", state.backend, AI_RANDOM);
+    PlaceFleet(players[1], fleets[0]);
+    PlayShots(players[0], players[1], shotOrders[0], NUM_CELLS - 1);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        sunk += AreAllShipsSunkScan(players[1]);
+    }
+
+    benchmarkSink = sunk;
+}
+
+static void BenchSetupAIBoards(BenchmarkState& state)
+{
+    Player player;
+
+    SetupPlayer(player, "Player1", state.backend, AI_RANDOM);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        ClearBoards(player);                                            // Part of the timing, SetupAIBoards expects a cleared board
+        SetupAIBoards(player);
+    }
+
+    benchmarkSink = player.ships[0].shipPosition.col;
+}
+
+static void BenchClearBoards(BenchmarkState& state)
+{
+    Player player;
+
+    SetupPlayer(player, "Player1", state.backend, state.strategy);
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        ClearBoards(player);
+    }
+
+    benchmarkSink = player.shipsRemaining;
+}
+
+static void BenchSessionPool(BenchmarkState& state)                    // A session's slot taken and given back, its two Players cleared
+{
+    static SessionPool pool;
+
+    CreateSessionPool(pool, 2 * sizeof(Player), 64);
+
+    Player* players = (Player*)AcquireSessionSlot(pool);
+
+    SetupPlayer(players[0], "Player1", state.backend, state.strategy);
+    SetupPlayer(players[1], "Player2", state.backend, state.strategy);
+    ReleaseSessionSlot(pool, players);
+
+    for (long long i = 0; i < state.iterations; i++)                    // The free list is last in, first out, so this is the same slot
+    {
+        players = (Player*)AcquireSessionSlot(pool);
+
+        ClearBoards(players[0]);
+        ClearBoards(players[1]);
+        ReleaseSessionSlot(pool, players);
+    }
+
+    benchmarkSink = players[1].shipsRemaining;
+    DestroySessionPool(pool);
+}
+
+static void BenchPlacementHeatmap(BenchmarkState& state)                 // What the density AI recounts after every sunk ship
+{
+    static const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1] = { 0, 0, 1, 2, 1, 1 };
+    BoardMask blockedMasks[NUM_FLEETS];
+    unsigned char heatmap[NUM_CELLS];
+    int total = 0;
+
+    for (int i = 0; i < NUM_FLEETS; i++)                                // 30 blocked cells, like a board a third of the way in
+    {
+        blockedMasks[i] = EmptyMask();
+
+        for (int k = 0; k < 30; k++)
+        {
+            SetCell(blockedMasks[i], shotOrders[i][k]);
+        }
+    }
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        ComputePlacementHeatmap(blockedMasks[i % NUM_FLEETS], shipsAfloat, heatmap);
+        total += heatmap[i % NUM_CELLS];
+    }
+
+    benchmarkSink = total;
+}
+
+static void BenchGetAIGuess(BenchmarkState& state)
+{
+    Player players[2];
+    int cells = 0;
+
+    SetupPlayer(players[0], "Player1", BB_BITBOARD, state.strategy);
+    SetupPlayer(players[1], "Player2", BB_BITBOARD, AI_RANDOM);
+    PlaceFleet(players[1], fleets[0]);
+    PlayShots(players[0], players[1], shotOrders[0], 30);               // Misses, hits and usually a sunk ship to reason about
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        ShipPositionType guess = GetAIGuess(players[0]);
+
+        cells += guess.row * BOARD_SIZE + guess.col;
+    }
+
+    benchmarkSink = cells;
+}
+
+static void BenchParseMove(BenchmarkState& state)
+{
+    static const char* lines[8] = { "B7", "b 7", "J10", "a,1", "B7 H", "c3v", "E 5 vertical", "z9" };
+    MoveInput move;
+    int parsed = 0;
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        parsed += ParseMove(lines[i & 7], BOARD_SIZE, BOARD_SIZE, move);
+    }
+
+    state.items = state.iterations;
+    benchmarkSink = parsed;
+}
+
+static void BenchSimulateGame(BenchmarkState& state)
+{
+    int turns = 0;
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        turns += SimulateGame(state.strategy, state.strategy, (unsigned int)i, nullptr).turns;
+    }
+
+    state.items = state.iterations;
+    benchmarkSink = turns;
+}
+
+static void BenchFullGame(BenchmarkState& state)                       // SimulateGame's loop on a chosen backend, through the runtime hooks
+{
+    Player players[2];
+    int turns = 0;
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        SeedThreadRandom(i);
+
+        for (int p = 0; p < 2; p++)
+        {
+            SetupPlayer(players[p], p == 0 ? "Player1" : "Player2", state.backend, state.strategy);
+            SetupAIBoards(players[p]);
+        }
+
+        int current = 0;
+
+        do
+        {
+            ShipPositionType guess;
+
+            do
+            {
+                guess = GetAIGuess(players[current]);
+
+            } while (GetGuessAt(players[current], guess.row, guess.col) != GT_NONE);
+
+            UpdateBoards(guess, players[current], players[1 - current]);
+
+            turns++;
+            current = 1 - current;
+
+        } while (!IsGameOver(players[0], players[1]));
+    }
+
+    state.items = state.iterations;
+    benchmarkSink = turns;
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "IsValidPlacement/array", BenchIsValidPlacement, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "IsValidPlacement/bitboard", BenchIsValidPlacement, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "PlaceShipOnBoard/array", BenchPlaceShipOnBoard, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "PlaceShipOnBoard/bitboard", BenchPlaceShipOnBoard, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "UpdateBoards/array", BenchUpdateBoards, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "UpdateBoards/bitboard", BenchUpdateBoards, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "UpdateBoards/bitboard/density", BenchUpdateBoards, BB_BITBOARD, AI_DENSITY, PK_AUTO },
+    { "IsSunk", BenchIsSunk, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "IsSunkScan/array", BenchIsSunkScan, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "IsSunkScan/bitboard", BenchIsSunkScan, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "AreAllShipsSunk", BenchAreAllShipsSunk, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "AreAllShipsSunkScan/array", BenchAreAllShipsSunkScan, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "AreAllShipsSunkScan/bitboard", BenchAreAllShipsSunkScan, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "SetupAIBoards/array", BenchSetupAIBoards, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "SetupAIBoards/bitboard", BenchSetupAIBoards, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "ClearBoards/array", BenchClearBoards, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "ClearBoards/bitboard", BenchClearBoards, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "ClearBoards/bitboard/density", BenchClearBoards, BB_BITBOARD, AI_DENSITY, PK_AUTO },
+    { "SessionPool/bitboard", BenchSessionPool, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "PlacementHeatmap/scalar", BenchPlacementHeatmap, BB_BITBOARD, AI_DENSITY, PK_SCALAR },
+    { "PlacementHeatmap/sse2", BenchPlacementHeatmap, BB_BITBOARD, AI_DENSITY, PK_SSE2 },
+    { "PlacementHeatmap/avx2", BenchPlacementHeatmap, BB_BITBOARD, AI_DENSITY, PK_AVX2 },
+    { "GetAIGuess/random", BenchGetAIGuess, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "GetAIGuess/density", BenchGetAIGuess, BB_BITBOARD, AI_DENSITY, PK_AUTO },
+    { "GetAIGuess/endgame", BenchGetAIGuess, BB_BITBOARD, AI_ENDGAME, PK_AUTO },
+    { "GetAIGuess/montecarlo", BenchGetAIGuess, BB_BITBOARD, AI_MONTE_CARLO, PK_AUTO },
+    { "GetAIGuess/parity", BenchGetAIGuess, BB_BITBOARD, AI_PARITY, PK_AUTO },
+    { "ParseMove", BenchParseMove, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "SimulateGame/random", BenchSimulateGame, BB_BITBOARD, AI_RANDOM, PK_AUTO },
+    { "SimulateGame/density", BenchSimulateGame, BB_BITBOARD, AI_DENSITY, PK_AUTO },
+    { "FullGame/array", BenchFullGame, BB_ARRAY, AI_RANDOM, PK_AUTO },
+    { "FullGame/bitboard", BenchFullGame, BB_BITBOARD, AI_RANDOM, PK_AUTO }
+};
+
+/* Runner */
+
+static double RunOnce(const Benchmark& benchmark, long long iterations, BenchmarkState& state)
+{
+    state.iterations = iterations;
+    state.backend = benchmark.backend;
+    state.strategy = benchmark.strategy;
+    state.items = 0;
+    state.pausedTime = chrono::steady_clock::duration::zero();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    benchmark.function(state);
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start - state.pausedTime).count();
+}
+
+static BenchmarkResult RunBenchmark(const Benchmark& benchmark, double minSeconds)
+{
+    BenchmarkState state;
+    long long iterations = 1;
+    double seconds = RunOnce(benchmark, iterations, state);
+
+    while (seconds < minSeconds && iterations < MAX_BENCHMARK_ITERATIONS)   // Aim 40% past the minimum, growing at most tenfold per run
+    {
+        double factor = seconds > 0 ? minSeconds * 1.4 / seconds : 10.0;
+
+        iterations = (long long)(iterations * (factor < 10.0 ? factor : 10.0)) + 1;
+        seconds = RunOnce(benchmark, iterations, state);
+    }
+
+    BenchmarkResult result;
+
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.nanosecondsPerIteration = seconds * 1e9 / iterations;
+    result.itemsPerSecond = state.items > 0 && seconds > 0 ? state.items / seconds : 0.0;
+
+    return result;
+}
+
+static void PrintResult(const BenchmarkResult& result)
+{
+    cout << left << setw(34) << result.name << right << fixed << setprecision(1) << setw(14) << result.nanosecondsPerIteration << " ns" << setw(14) << result.iterations;
+
+    if (result.itemsPerSecond > 0)
+    {
+        cout << setw(16) << setprecision(0) << result.itemsPerSecond << " items/s";
+    }
+
+    cout << endl;
+}
+
+static string JsonEscape(const string& text)
+{
+    string escaped;
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (text[i] == '"' || text[i] == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += text[i];
+    }
+    return escaped;
+}
+
+static bool WriteJson(const char* path, const vector<BenchmarkResult>& results)
+{
+    ofstream out(path);
+
+    if (!out)
+    {
+        return false;
+    }
+
+    char date[32];
+    time_t now = time(NULL);
+    struct tm local;
+
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &local);
+
+    out << "{" << endl;
+    out << "  \"context\": {" << endl;
+    out << "    \"date\": \"" << date << "\"," << endl;
+    out << "    \"num_cpus\": " << GetHardwareThreadCount() << "," << endl;
+    out << "    \"placement_kernel\": \"" << GetPlacementKernelName(GetPlacementKernel()) << "\"," << endl;
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"" << endl;
+#else
+    out << "    \"library_build_type\": \"debug\"" << endl;
+#endif
+    out << "  }," << endl;
+    out << "  \"benchmarks\": [" << endl;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult& result = results[i];
+
+        out << "    {" << endl;
+        out << "      \"name\": \"" << JsonEscape(result.name) << "\"," << endl;
+        out << "      \"run_type\": \"iteration\"," << endl;
+        out << "      \"iterations\": " << result.iterations << "," << endl;
+        out << "      \"real_time\": " << setprecision(17) << result.nanosecondsPerIteration << "," << endl;
+
+        if (result.itemsPerSecond > 0)
+        {
+            out << "      \"items_per_second\": " << result.itemsPerSecond << "," << endl;
+        }
+
+        out << "      \"time_unit\": \"ns\"" << endl;
+        out << "    }" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+
+    out << "  ]" << endl;
+    out << "}" << endl;
+
+    return bool(out);
+}
+
+static bool ParseBenchmarkOptions(int argc, char* argv[], BenchmarkOptions& options)
+{
+    options.filter = nullptr;
+    options.jsonPath = nullptr;
+    options.minSeconds = 0.2;
+    options.seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "--filter") == 0 && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--json") == 0 && hasValue)
+        {
+            options.jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue)
+        {
+            options.minSeconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.minSeconds > 0;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+
+    if (!ParseBenchmarkOptions(argc, argv, options))
+    {
+        cout << "Usage: " << argv[0] << " [--filter TEXT] [--min-time SECONDS] [--json FILE] [--seed S]" << endl;
+        return 1;
+    }
+
+    SetThreadPoolSize(1);                                               // Single-threaded numbers, the Monte Carlo AI included
+    PrepareFixtures(options.seed);
+
+    cout << left << setw(34) << "Benchmark" << right << setw(17) << "Time" << setw(14) << "Iterations" << endl;
+    cout << string(65, '-') << endl;
+
+    vector<BenchmarkResult> results;
+
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+    {
+        if (options.filter != nullptr && strstr(benchmarks[i].name, options.filter) == nullptr)
+        {
+            continue;
+        }
+
+        if (!SetPlacementKernel(benchmarks[i].kernel))
+        {
+            cout << left << setw(34) << benchmarks[i].name << "not supported on this CPU" << endl;
+            continue;
+        }
+
+        SeedThreadRandom(options.seed);
+
+        results.push_back(RunBenchmark(benchmarks[i], options.minSeconds));
+        PrintResult(results.back());
+    }
+
+    if (options.jsonPath != nullptr && !WriteJson(options.jsonPath, results))
+    {
+        cout << "Could not write " << options.jsonPath << endl;
+        return 1;
+    }
+
+    return 0;
+}
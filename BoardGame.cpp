@@ -0,0 +1,49 @@
+// BoardGame.cpp : Runtime selection among the compile-time board and fleet variants.
+//
+
+#include <cstring>
+#include "BoardGame.h"
+#include "Simulation.h"
+
+typedef GameResult (*VariantSimulator)(unsigned int seed);
+
+static GameResult SimulateClassicGame(unsigned int seed)                 // The Player path, which ClassicGame sizes
+{
+    return SimulateGame(AI_RANDOM, AI_RANDOM, seed, nullptr);
+}
+
+struct GameVariantInfo
+{
+    const char* name;
+    VariantSimulator simulate;
+};
+
+static const GameVariantInfo gameVariants[NUM_GAME_VARIANTS] =
+{
+    { "classic", &SimulateClassicGame },
+    { "quick",   &QuickGame::SimulateRandomGame },
+    { "large",   &LargeGame::SimulateRandomGame }
+};
+
+GameResult SimulateVariantGame(GameVariantType variant, unsigned int seed)
+{
+    return gameVariants[variant].simulate(seed);
+}
+
+const char* GetGameVariantName(GameVariantType variant)
+{
+    return gameVariants[variant].name;
+}
+
+bool ParseGameVariant(const char* name, GameVariantType& variant)
+{
+    for (int i = 0; i < NUM_GAME_VARIANTS; i++)
+    {
+        if (strcmp(name, gameVariants[i].name) == 0)
+        {
+            variant = GameVariantType(i);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,425 @@
+#pragma once
+
+#ifndef __BOARDGAME_H__
+#define __BOARDGAME_H__
+
+#include <cstdint>
+#include <type_traits>
+#include "BoardMask.h"
+#include "Random.h"
+
+/*
+    Board size and fleet as compile-time parameters. Game<Rows, Cols, Fleet> gets its own mask width,
+    ship count and loop bounds, so every variant compiles to fixed-size, unrollable loops and the
+    classic 10x10 game pays nothing for the 20x20 one existing. The variants that are built in are
+    picked at runtime with SimulateVariantGame.
+
+    Every variant shares one set of building blocks: the placement lists and the bounded placement
+    sampler, and the pool of unguessed cells the random shooter draws from. ClassicGame is the
+    game the rest of the program plays. Game.h takes BOARD_SIZE, NUM_SHIPS and the ship sizes from
+    it, and Player, the AI strategies, FleetSampler and the game log are built for its dimensions.
+    The other variants only have SimulateRandomGame, random fire against random fleets.
+*/
+
+enum GameVariantType
+{
+    GV_CLASSIC = 0,                                                     // 10x10, ships 5 4 3 3 2
+    GV_QUICK,                                                           // 8x8, ships 4 3 3 2
+    GV_LARGE,                                                           // 20x20, ships 6 5 5 4 4 3 3 2 2
+    NUM_GAME_VARIANTS
+};
+
+enum
+{
+    MAX_VARIANT_TURNS = 2 * 20 * 20                                     // Longest game of the largest variant
+};
+
+struct GameResult
+{
+    int winner;                                                         // 0 if the first player won, 1 for the second
+    int turns;                                                          // Shots fired by both players together
+    int shots[2];
+    int hits[2];
+};
+
+template <int... Sizes>
+struct Fleet
+{
+    static constexpr int NUM_SHIPS = sizeof...(Sizes);
+
+    static constexpr int ShipSize(int ship)
+    {
+        const int sizes[] = { Sizes... };
+        return sizes[ship];
+    }
+
+    static constexpr int MaxShipSize()
+    {
+        int size = 0;
+
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            size = ShipSize(ship) > size ? ShipSize(ship) : size;
+        }
+        return size;
+    }
+};
+
+typedef Fleet<5, 4, 3, 3, 2> ClassicFleet;                              // In ShipType order, carrier first
+typedef Fleet<4, 3, 3, 2> QuickFleet;
+typedef Fleet<6, 5, 5, 4, 4, 3, 3, 2, 2> LargeFleet;
+
+/* Cell masks wider than BoardMask, with the same free functions */
+
+template <int Cells>
+struct CellMask
+{
+    static constexpr int WORDS = (Cells + 63) / 64;
+
+    uint64_t bits[WORDS];
+};
+
+template <int Cells>
+inline void SetCell(CellMask<Cells>& mask, int cell)
+{
+    mask.bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+}
+
+template <int Cells>
+inline bool TestCell(const CellMask<Cells>& mask, int cell)
+{
+    return (mask.bits[cell >> 6] >> (cell & 63)) & 1;
+}
+
+template <int Cells>
+inline bool MaskIntersects(const CellMask<Cells>& a, const CellMask<Cells>& b)
+{
+    uint64_t any = 0;
+
+    for (int i = 0; i < CellMask<Cells>::WORDS; i++)
+    {
+        any |= a.bits[i] & b.bits[i];
+    }
+    return any != 0;
+}
+
+template <int Cells>
+inline CellMask<Cells> MaskOr(const CellMask<Cells>& a, const CellMask<Cells>& b)
+{
+    CellMask<Cells> mask;
+
+    for (int i = 0; i < CellMask<Cells>::WORDS; i++)
+    {
+        mask.bits[i] = a.bits[i] | b.bits[i];
+    }
+    return mask;
+}
+
+template <int Cells>                                                    // BoardMask up to 128 cells, so ClassicGame's masks are the Player masks
+using CellMaskType = typename std::conditional<(Cells <= BOARD_MASK_CELLS), BoardMask, CellMask<Cells>>::type;
+
+template <int Count>                                                    // Smallest type that indexes Count things
+using IndexType = typename std::conditional<(Count <= 256), unsigned char, unsigned short>::type;
+
+/*
+    The cells a player has not fired at. cells[numFired..] are the open ones in no particular
+    order and positions[] says where each cell is, so a draw and a removal are both constant time.
+*/
+template <int Cells>
+struct CellPool
+{
+    typedef IndexType<Cells> CellType;
+
+    CellType cells[Cells];
+    CellType positions[Cells];                                          // Where each cell is in cells[]
+    int numFired;
+};
+
+template <int Cells>
+inline void FillCellPool(CellPool<Cells>& pool)
+{
+    typedef typename CellPool<Cells>::CellType CellType;
+
+    for (int cell = 0; cell < Cells; cell++)
+    {
+        pool.cells[cell] = (CellType)cell;
+        pool.positions[cell] = (CellType)cell;
+    }
+    pool.numFired = 0;
+}
+
+template <int Cells>
+inline int DrawFromCellPool(const CellPool<Cells>& pool, RandomState& random)   // A uniform pick among the open cells, left in the pool; -1 if none
+{
+    if (pool.numFired >= Cells)
+    {
+        return -1;
+    }
+    return pool.cells[pool.numFired + RandomInt(random, Cells - pool.numFired)];
+}
+
+template <int Cells>
+inline void RemoveFromCellPool(CellPool<Cells>& pool, int cell)         // Cells already fired at are ignored
+{
+    typedef typename CellPool<Cells>::CellType CellType;
+
+    int position = pool.positions[cell];
+
+    if (position < pool.numFired)
+    {
+        return;
+    }
+
+    int first = pool.cells[pool.numFired];
+
+    pool.cells[position] = (CellType)first;
+    pool.positions[first] = (CellType)position;
+    pool.cells[pool.numFired] = (CellType)cell;
+    pool.positions[cell] = (CellType)pool.numFired;
+    pool.numFired++;
+}
+
+template <typename MaskType>
+struct BasicShipPlacement
+{
+    MaskType mask;                                                      // The cells the ship covers
+    unsigned char row;
+    unsigned char col;
+    unsigned char orientation;                                          // ShipOrientationType
+};
+
+template <int Rows, int Cols, typename FleetType>
+struct Game
+{
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr int CELLS = Rows * Cols;
+    static constexpr int NUM_SHIPS = FleetType::NUM_SHIPS;
+    static constexpr int MAX_SHIP_SIZE = FleetType::MaxShipSize();
+    static constexpr int MAX_PLACEMENTS = 2 * CELLS;                    // Upper bound on placements of one ship on an empty board
+    static constexpr int MAX_REJECTED_DRAWS = 8;                        // Then a placement is picked among the legal ones directly
+
+    typedef CellMaskType<CELLS> Mask;
+    typedef BasicShipPlacement<Mask> Placement;
+    typedef CellPool<CELLS> ShotPool;
+
+    struct FleetLayout                                                  // A whole fleet, ships in FleetType order
+    {
+        Placement ships[NUM_SHIPS];
+        Mask occupiedMask;
+    };
+
+    struct PlacementTables
+    {
+        Placement placements[MAX_SHIP_SIZE + 1][MAX_PLACEMENTS];        // By size, every placement that fits on an empty board
+        int numPlacements[MAX_SHIP_SIZE + 1];
+    };
+
+    struct Side                                                         // One player's fleet plus their shots at the other fleet
+    {
+        Mask occupied;
+        Mask shipCells[NUM_SHIPS];
+        unsigned char shipHits[NUM_SHIPS];
+        int shipsRemaining;
+        ShotPool shots;
+    };
+
+    static Mask LineMask(int row, int col, int length, bool vertical)
+    {
+        Mask mask = {};
+
+        for (int i = 0; i < length; i++)
+        {
+            SetCell(mask, vertical ? (row + i) * Cols + col : row * Cols + col + i);
+        }
+        return mask;
+    }
+
+    static bool BuildPlacementTables(PlacementTables& tables)           // Filled in place, the 20x20 tables are too big for a stack
+    {
+        for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+        {
+            int count = 0;
+
+            for (int orientation = 0; orientation <= 1; orientation++)  // SO_HORIZONTAL, then SO_VERTICAL
+            {
+                bool vertical = orientation == 1;
+
+                for (int r = 0; r + (vertical ? size : 1) <= Rows; r++)
+                {
+                    for (int c = 0; c + (vertical ? 1 : size) <= Cols; c++)
+                    {
+                        Placement& placement = tables.placements[size][count++];
+
+                        placement.mask = LineMask(r, c, size, vertical);
+                        placement.row = (unsigned char)r;
+                        placement.col = (unsigned char)c;
+                        placement.orientation = (unsigned char)orientation;
+                    }
+                }
+            }
+
+            tables.numPlacements[size] = count;
+        }
+        return true;
+    }
+
+    static const PlacementTables& GetPlacementTables()
+    {
+        static PlacementTables tables;
+        static const bool isBuilt = BuildPlacementTables(tables);       // Once, thread-safe static initialization
+
+        (void)isBuilt;
+        return tables;
+    }
+
+    /*
+        A ship is placed by drawing from the list for its size and rejecting draws that cover a
+        blocked cell. After a few rejected draws the legal placements are gathered and one is picked
+        directly, so a ship never costs more than a short scan of its list. Either way every legal
+        placement is equally likely.
+    */
+    static bool SampleShipPlacement(RandomState& random, const Mask& blockedMask, int shipSize, Placement& placement)
+    {
+        const PlacementTables& tables = GetPlacementTables();
+        const Placement* placements = tables.placements[shipSize];
+        int numPlacements = tables.numPlacements[shipSize];
+
+        for (int draw = 0; draw < MAX_REJECTED_DRAWS; draw++)           // A uniform draw that passes is uniform over the legal ones
+        {
+            const Placement& candidate = placements[RandomInt(random, numPlacements)];
+
+            if (!MaskIntersects(candidate.mask, blockedMask))
+            {
+                placement = candidate;
+                return true;
+            }
+        }
+
+        IndexType<MAX_PLACEMENTS> legal[MAX_PLACEMENTS];
+        int numLegal = 0;
+
+        for (int i = 0; i < numPlacements; i++)
+        {
+            legal[numLegal] = (IndexType<MAX_PLACEMENTS>)i;
+            numLegal += !MaskIntersects(placements[i].mask, blockedMask);
+        }
+
+        if (numLegal == 0)
+        {
+            return false;
+        }
+
+        placement = placements[legal[RandomInt(random, numLegal)]];
+        return true;
+    }
+
+    static void GenerateRandomFleet(RandomState& random, FleetLayout& fleet)
+    {
+        bool isPlaced;
+
+        do                                                              // Starts over only if the fleet boxed itself in
+        {
+            fleet.occupiedMask = Mask();
+            isPlaced = true;
+
+            for (int i = 0; i < NUM_SHIPS && isPlaced; i++)
+            {
+                isPlaced = SampleShipPlacement(random, fleet.occupiedMask, FleetType::ShipSize(i), fleet.ships[i]);
+                fleet.occupiedMask = MaskOr(fleet.occupiedMask, fleet.ships[i].mask);
+            }
+
+        } while (!isPlaced);
+    }
+
+    static void ClearSide(Side& side, RandomState& random)              // A fresh random fleet, nothing fired yet
+    {
+        FleetLayout fleet;
+
+        GenerateRandomFleet(random, fleet);
+
+        side.occupied = fleet.occupiedMask;
+
+        for (int i = 0; i < NUM_SHIPS; i++)
+        {
+            side.shipCells[i] = fleet.ships[i].mask;
+            side.shipHits[i] = 0;
+        }
+
+        side.shipsRemaining = NUM_SHIPS;
+        FillCellPool(side.shots);
+    }
+
+    static int Fire(Side& defender, int cell)                           // Index of the ship hit, or -1 for a miss
+    {
+        if (!TestCell(defender.occupied, cell))
+        {
+            return -1;
+        }
+
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            if (TestCell(defender.shipCells[ship], cell))
+            {
+                if (++defender.shipHits[ship] == FleetType::ShipSize(ship))
+                {
+                    defender.shipsRemaining--;
+                }
+                return ship;
+            }
+        }
+        return -1;
+    }
+
+    static GameResult SimulateRandomGame(unsigned int seed)
+    {
+        RandomState random;
+        Side sides[2];
+        GameResult result = {};
+
+        SeedRandom(random, seed);
+
+        for (int i = 0; i < 2; i++)
+        {
+            ClearSide(sides[i], random);
+        }
+
+        int current = 0;
+
+        do
+        {
+            int cell = DrawFromCellPool(sides[current].shots, random);
+
+            RemoveFromCellPool(sides[current].shots, cell);
+            result.shots[current]++;
+
+            if (Fire(sides[1 - current], cell) >= 0)
+            {
+                result.hits[current]++;
+            }
+
+            result.turns++;
+            current = 1 - current;
+
+        } while (sides[0].shipsRemaining > 0 && sides[1].shipsRemaining > 0);
+
+        result.winner = sides[1].shipsRemaining == 0 ? 0 : 1;
+
+        return result;
+    }
+
+};
+
+typedef Game<10, 10, ClassicFleet> ClassicGame;
+typedef Game<8, 8, QuickFleet> QuickGame;
+typedef Game<20, 20, LargeFleet> LargeGame;
+
+static_assert(LargeGame::CELLS * 2 <= MAX_VARIANT_TURNS, "MAX_VARIANT_TURNS must cover the largest variant");
+
+/* Runtime factory over the precompiled variants */
+
+GameResult SimulateVariantGame(GameVariantType variant, unsigned int seed);   // Random fire against random fleets on that variant's board
+const char* GetGameVariantName(GameVariantType variant);
+bool ParseGameVariant(const char* name, GameVariantType& variant);
+
+#endif
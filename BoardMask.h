@@ -0,0 +1,157 @@
+#pragma once
+
+#ifndef __BOARDMASK_H__
+#define __BOARDMASK_H__
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+    128-bit board mask. Cell (row, col) lives at bit (row * BOARD_MASK_STRIDE + col),
+    so a 10x10 board uses bits 0 - 99 of the two 64-bit words.
+*/
+
+enum
+{
+    BOARD_MASK_WORDS = 2,
+    BOARD_MASK_STRIDE = 10,
+    BOARD_MASK_CELLS = BOARD_MASK_WORDS * 64
+};
+
+struct BoardMask
+{
+    uint64_t bits[BOARD_MASK_WORDS];
+};
+
+inline int PopCount64(uint64_t value)
+{
+#ifdef _MSC_VER
+    return (int)__popcnt64(value);
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+
+inline int CountTrailingZeros64(uint64_t value)                          // value must not be 0
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+inline BoardMask EmptyMask()
+{
+    BoardMask mask = { { 0, 0 } };
+    return mask;
+}
+
+inline int CellIndex(int row, int col)
+{
+    return row * BOARD_MASK_STRIDE + col;
+}
+
+inline void SetCell(BoardMask& mask, int cell)
+{
+    mask.bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+}
+
+inline void ClearCell(BoardMask& mask, int cell)
+{
+    mask.bits[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+}
+
+inline bool TestCell(const BoardMask& mask, int cell)
+{
+    return (mask.bits[cell >> 6] >> (cell & 63)) & 1;
+}
+
+inline BoardMask MaskAnd(const BoardMask& a, const BoardMask& b)
+{
+    BoardMask mask = { { a.bits[0] & b.bits[0], a.bits[1] & b.bits[1] } };
+    return mask;
+}
+
+inline BoardMask MaskOr(const BoardMask& a, const BoardMask& b)
+{
+    BoardMask mask = { { a.bits[0] | b.bits[0], a.bits[1] | b.bits[1] } };
+    return mask;
+}
+
+inline BoardMask MaskAndNot(const BoardMask& a, const BoardMask& b)      // a & ~b
+{
+    BoardMask mask = { { a.bits[0] & ~b.bits[0], a.bits[1] & ~b.bits[1] } };
+    return mask;
+}
+
+inline bool MaskIsEmpty(const BoardMask& mask)
+{
+    return (mask.bits[0] | mask.bits[1]) == 0;
+}
+
+inline bool MaskIntersects(const BoardMask& a, const BoardMask& b)
+{
+    return ((a.bits[0] & b.bits[0]) | (a.bits[1] & b.bits[1])) != 0;
+}
+
+inline bool MaskEquals(const BoardMask& a, const BoardMask& b)
+{
+    return a.bits[0] == b.bits[0] && a.bits[1] == b.bits[1];
+}
+
+inline int MaskPopCount(const BoardMask& mask)
+{
+    return PopCount64(mask.bits[0]) + PopCount64(mask.bits[1]);
+}
+
+inline int MaskFirstCell(const BoardMask& mask)                           // -1 if the mask is empty
+{
+    if (mask.bits[0] != 0)
+    {
+        return CountTrailingZeros64(mask.bits[0]);
+    }
+    if (mask.bits[1] != 0)
+    {
+        return 64 + CountTrailingZeros64(mask.bits[1]);
+    }
+    return -1;
+}
+
+inline int MaskNthCell(const BoardMask& mask, int n)                      // n must be below MaskPopCount(mask), takes up to n steps
+{
+    int lowCount = PopCount64(mask.bits[0]);
+    int word = n < lowCount ? 0 : 1;
+    uint64_t bits = mask.bits[word];
+
+    for (n -= word * lowCount; n > 0; n--)
+    {
+        bits &= bits - 1;                                               // Drop the lowest set bit
+    }
+    return word * 64 + CountTrailingZeros64(bits);
+}
+
+/*
+    Mask for a straight line of 'length' cells starting at (row, col). Horizontal lines step one bit,
+    vertical lines step one stride. The caller is responsible for keeping the line on the board.
+*/
+inline BoardMask LineMask(int row, int col, int length, bool vertical)
+{
+    BoardMask mask = EmptyMask();
+    int cell = CellIndex(row, col);
+    int step = vertical ? BOARD_MASK_STRIDE : 1;
+
+    for (int i = 0; i < length; i++)
+    {
+        SetCell(mask, cell);
+        cell += step;
+    }
+    return mask;
+}
+
+#endif
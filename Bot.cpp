@@ -0,0 +1,119 @@
+// Bot.cpp : A built-in AI behind the referee protocol, for matches against external engines.
+//
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include "Bot.h"
+#include "Referee.h"
+#include "Input.h"
+#include "Random.h"
+
+using namespace std;
+
+/*
+    "result sunk 3 E1 V" carries the ship and where it was placed, which is all OnSunk needs; a
+    plain hit or miss is told about the shot just fired.
+*/
+static void ApplyResult(BotEngine& bot, const char* result)
+{
+    Player& player = bot.player;
+    int cell = CellIndex(bot.lastShot.row, bot.lastShot.col);
+    int shipNumber = 0;
+    char shipCell[8];
+    MoveInput move;
+
+    if (strncmp(result, "miss", 4) == 0)
+    {
+        ApplyShotOutcome(player, bot.lastShot, false, ST_NONE, EmptyMask());
+        bot.strategy->OnMiss(player, cell);
+    }
+    else if (strncmp(result, "hit", 3) == 0)
+    {
+        ApplyShotOutcome(player, bot.lastShot, true, ST_NONE, EmptyMask());
+        bot.strategy->OnHit(player, cell);
+    }
+    else if (sscanf(result, "sunk %d %7[A-Za-z0-9 ]", &shipNumber, shipCell) == 2 && shipNumber >= 1 && shipNumber <= NUM_SHIPS &&
+             ParseMove(shipCell, BOARD_SIZE, BOARD_SIZE, move) == MP_CELL_AND_ORIENTATION)
+    {
+        int shipSize = player.ships[shipNumber - 1].shipSize;           // Both fleets have the same make-up
+        BoardMask shipCells = LineMask(move.row, move.col, shipSize, move.orientation == 'V');
+
+        ApplyShotOutcome(player, bot.lastShot, true, ShipType(shipNumber), shipCells);
+        bot.strategy->OnHit(player, cell);
+        bot.strategy->OnSunk(player, shipCells, shipSize);
+    }
+}
+
+void InitializeBotEngine(BotEngine& bot, AIStrategyType strategy)
+{
+    InitializePlayer(bot.player, GetAIStrategyName(strategy));
+    bot.player.playerType = PT_AI;
+    bot.player.aiStrategy = strategy;
+    bot.strategy = &GetStrategy(strategy);
+    bot.lastShot.row = 0;
+    bot.lastShot.col = 0;
+}
+
+BotAnswerType AnswerReferee(BotEngine& bot, const char* message, char answer[], int answerSize)
+{
+    if (strncmp(message, "battleship", 10) == 0)
+    {
+        snprintf(answer, size_t(answerSize), "ready %s", GetAIStrategyName(bot.player.aiStrategy));
+        return BA_ANSWER;
+    }
+    if (strcmp(message, "place") == 0)
+    {
+        ClearBoards(bot.player);
+        bot.strategy->PlaceFleet(bot.player);
+        FormatProtocolFleet(bot.player, answer, answerSize);
+        return BA_ANSWER;
+    }
+    if (strcmp(message, "shoot") == 0)
+    {
+        do
+        {
+            bot.lastShot = bot.strategy->ChooseShot(bot.player);
+
+        } while (GetGuessAt(bot.player, bot.lastShot.row, bot.lastShot.col) != GT_NONE);
+
+        FormatProtocolCell(bot.lastShot.row, bot.lastShot.col, answer);
+        return BA_ANSWER;
+    }
+    if (strncmp(message, "result ", 7) == 0)
+    {
+        ApplyResult(bot, message + 7);
+    }
+    else if (strcmp(message, "quit") == 0)
+    {
+        return BA_QUIT;
+    }
+    return BA_NONE;                                                     // incoming and end need no answer
+}
+
+int RunBot(AIStrategyType strategy, unsigned int seed)
+{
+    static BotEngine bot;
+    InputReader& input = GetStandardInput();
+    char line[MAX_INPUT_LINE];
+    char answer[MAX_PROTOCOL_LINE];
+
+    SeedThreadRandom(seed);
+    InitializeBotEngine(bot, strategy);
+
+    while (ReadInputLine(input, line, sizeof(line)))
+    {
+        BotAnswerType type = AnswerReferee(bot, line, answer, sizeof(answer));
+
+        if (type == BA_QUIT)
+        {
+            break;
+        }
+        if (type == BA_ANSWER)
+        {
+            cout << answer << endl;
+        }
+    }
+
+    return 0;
+}
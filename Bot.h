@@ -0,0 +1,37 @@
+#pragma once
+
+#ifndef __BOT_H__
+#define __BOT_H__
+
+#include "Game.h"
+#include "Strategy.h"
+
+/*
+    The engine side of the referee protocol (see Referee.h), played by one of the built-in AI
+    strategies. The bot only learns what the protocol tells it: its own shots' results and the
+    cells of the ships it sinks, which is all the strategies look at.
+
+    AnswerReferee takes one message and gives the answer, if there is one, so the same bot runs
+    on stdin and stdout (RunBot) or on a socket (the server load test).
+*/
+
+enum BotAnswerType
+{
+    BA_NONE = 0,                                                        // Nothing to send back
+    BA_ANSWER,
+    BA_QUIT
+};
+
+struct BotEngine
+{
+    Player player;
+    const Strategy* strategy;
+    ShipPositionType lastShot;                                          // The results refer to it
+};
+
+void InitializeBotEngine(BotEngine& bot, AIStrategyType strategy);
+BotAnswerType AnswerReferee(BotEngine& bot, const char* message, char answer[], int answerSize);
+
+int RunBot(AIStrategyType strategy, unsigned int seed);                 // Returns once told to quit or the input ends
+
+#endif
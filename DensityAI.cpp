@@ -0,0 +1,317 @@
+// DensityAI.cpp : Hunt/target AI driven by placement density.
+//
+
+#include <cstring>
+#include <cassert>
+#include "DensityAI.h"
+#include "PlacementKernel.h"
+#include "Random.h"
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE,
+    TARGET_WEIGHT = 1                                                   // Score per (hit, placement through it) in target mode
+};
+
+struct DensityTables
+{
+    BoardMask placements[MAX_SHIP_SIZE + 1][2][NUM_CELLS];              // By size, orientation and first cell, empty when it runs off the board
+    short emptyBoardCounts[MAX_SHIP_SIZE + 1][NUM_CELLS];               // Placements of one ship of each size over each cell of an empty board
+    unsigned char fleetShipsAfloat[MAX_SHIP_SIZE + 1];                  // Ships of each size in the standard fleet
+    short emptyBoardDensity[NUM_CELLS];                                 // density of a fresh board against the standard fleet
+};
+
+static DensityTables BuildDensityTables()
+{
+    DensityTables tables;
+
+    memset(&tables, 0, sizeof(tables));
+
+    for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+    {
+        for (int r = 0; r < BOARD_SIZE; r++)
+        {
+            for (int c = 0; c < BOARD_SIZE; c++)
+            {
+                if (c + size <= BOARD_SIZE)
+                {
+                    tables.placements[size][SO_HORIZONTAL][CellIndex(r, c)] = LineMask(r, c, size, false);
+
+                    for (int k = 0; k < size; k++)
+                    {
+                        tables.emptyBoardCounts[size][CellIndex(r, c + k)]++;
+                    }
+                }
+                if (r + size <= BOARD_SIZE)
+                {
+                    tables.placements[size][SO_VERTICAL][CellIndex(r, c)] = LineMask(r, c, size, true);
+
+                    for (int k = 0; k < size; k++)
+                    {
+                        tables.emptyBoardCounts[size][CellIndex(r + k, c)]++;
+                    }
+                }
+            }
+        }
+    }
+
+    static const int fleetSizes[NUM_SHIPS] = { AIRCRAFT_CARRIER_SIZE, BATTLESHIP_SIZE, CRUISER_SIZE, DESTROYER_SIZE, SUBMARINE_SIZE };
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        tables.fleetShipsAfloat[fleetSizes[i]]++;
+    }
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+        {
+            tables.emptyBoardDensity[cell] = short(tables.emptyBoardDensity[cell] + tables.fleetShipsAfloat[size] * tables.emptyBoardCounts[size][cell]);
+        }
+    }
+    return tables;
+}
+
+static const DensityTables& GetDensityTables()
+{
+    static const DensityTables tables = BuildDensityTables();           // Built once, thread-safe static initialization
+
+    return tables;
+}
+
+static void RecountDensity(DensityState& state)                         // Full recount with the placement heatmap kernel
+{
+    unsigned char heatmap[NUM_CELLS];
+
+    ComputePlacementHeatmap(state.blockedMask, state.shipsAfloat, heatmap);
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        state.density[cell] = heatmap[cell];
+    }
+}
+
+void ResetDensityState(Player& player)
+{
+    const DensityTables& tables = GetDensityTables();
+    DensityState& state = player.densityState;
+
+    memset(state.shipsAfloat, 0, sizeof(state.shipsAfloat));
+
+    for (int i = 0; i < NUM_SHIPS; i++)                                 // Both fleets have the same make-up
+    {
+        state.shipsAfloat[player.ships[i].shipSize]++;
+    }
+
+    state.blockedMask = EmptyMask();
+
+    if (memcmp(state.shipsAfloat, tables.fleetShipsAfloat, sizeof(state.shipsAfloat)) == 0)
+    {
+        memcpy(state.density, tables.emptyBoardDensity, sizeof(state.density));   // Every game starts from the same board
+    }
+    else
+    {
+        RecountDensity(state);
+    }
+}
+
+/*
+    A cell became blocked: every placement through it that was still legal stops counting. Only the
+    placements through this one cell are visited, at most 2 * size of them per ship size.
+*/
+void UpdateDensityOnMiss(DensityState& state, int cell)
+{
+    if (TestCell(state.blockedMask, cell))
+    {
+        return;
+    }
+
+    const DensityTables& tables = GetDensityTables();
+    int row = cell / BOARD_SIZE;
+    int col = cell % BOARD_SIZE;
+
+    for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+    {
+        int afloat = state.shipsAfloat[size];
+
+        if (afloat == 0)
+        {
+            continue;
+        }
+
+        for (int k = 0; k < size; k++)
+        {
+            if (col - k >= 0)
+            {
+                int first = cell - k;
+                const BoardMask& placement = tables.placements[size][SO_HORIZONTAL][first];
+
+                if (!MaskIsEmpty(placement) && !MaskIntersects(placement, state.blockedMask))
+                {
+                    for (int p = first; p < first + size; p++)
+                    {
+                        state.density[p] -= afloat;
+                    }
+                }
+            }
+            if (row - k >= 0)
+            {
+                int first = cell - k * BOARD_SIZE;
+                const BoardMask& placement = tables.placements[size][SO_VERTICAL][first];
+
+                if (!MaskIsEmpty(placement) && !MaskIntersects(placement, state.blockedMask))
+                {
+                    for (int p = first; p < first + size * BOARD_SIZE; p += BOARD_SIZE)
+                    {
+                        state.density[p] -= afloat;
+                    }
+                }
+            }
+        }
+    }
+
+    SetCell(state.blockedMask, cell);
+}
+
+/*
+    A sink changes every cell's count at once, one ship size fewer and the ship's cells blocked, so
+    the density is recounted from scratch rather than patched. That happens five times a game.
+*/
+void UpdateDensityOnSunk(DensityState& state, const BoardMask& shipCells, int shipSize)
+{
+    state.shipsAfloat[shipSize]--;
+    state.blockedMask = MaskOr(state.blockedMask, shipCells);           // Nothing else can sit on a sunk ship's cells
+
+    RecountDensity(state);
+}
+
+static ShipPositionType CellToPosition(int cell)
+{
+    ShipPositionType position;
+
+    position.row = cell / BOARD_SIZE;
+    position.col = cell % BOARD_SIZE;
+
+    return position;
+}
+
+/*
+    Highest score among the unguessed cells, ties broken at random so the AI doesn't always open in
+    the same corner.
+*/
+static int PickBestCell(const int scores[], const BoardMask& guessedMask)
+{
+    RandomState& random = GetThreadRandom();
+    int bestCell = -1;
+    int bestScore = -1;
+    int ties = 0;
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        if (TestCell(guessedMask, cell))
+        {
+            continue;
+        }
+
+        if (scores[cell] > bestScore)
+        {
+            bestScore = scores[cell];
+            bestCell = cell;
+            ties = 1;
+        }
+        else if (scores[cell] == bestScore && RandomInt(random, ++ties) == 0)
+        {
+            bestCell = cell;
+        }
+    }
+    return bestCell;
+}
+
+ShipPositionType GetDensityGuess(const Player& aiPlayer)
+{
+    const DensityState& state = aiPlayer.densityState;
+    BoardMask guessedMask = MaskOr(aiPlayer.guessHitMask, aiPlayer.guessMissMask);
+    BoardMask openHits = MaskAndNot(aiPlayer.guessHitMask, state.blockedMask);   // Hits on ships that are still afloat
+    int scores[NUM_CELLS];
+
+#ifndef NDEBUG
+    unsigned char heatmap[NUM_CELLS];                                   // The incremental counts must match a full recount
+
+    ComputePlacementHeatmap(state.blockedMask, state.shipsAfloat, heatmap);
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        assert(heatmap[cell] == state.density[cell]);
+    }
+#endif
+
+    if (MaskIsEmpty(openHits))
+    {
+        for (int cell = 0; cell < NUM_CELLS; cell++)
+        {
+            scores[cell] = state.density[cell];
+        }
+    }
+    else
+    {
+        const DensityTables& tables = GetDensityTables();
+
+        memset(scores, 0, sizeof(scores));
+
+        for (int hit = MaskFirstCell(openHits); hit >= 0; hit = MaskFirstCell(openHits))
+        {
+            ClearCell(openHits, hit);
+
+            int row = hit / BOARD_SIZE;
+            int col = hit % BOARD_SIZE;
+
+            for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+            {
+                int weight = TARGET_WEIGHT * state.shipsAfloat[size];
+
+                if (weight == 0)
+                {
+                    continue;
+                }
+
+                for (int k = 0; k < size; k++)
+                {
+                    if (col - k >= 0)
+                    {
+                        int first = hit - k;
+                        const BoardMask& placement = tables.placements[size][SO_HORIZONTAL][first];
+
+                        if (!MaskIsEmpty(placement) && !MaskIntersects(placement, state.blockedMask))
+                        {
+                            for (int p = first; p < first + size; p++)
+                            {
+                                scores[p] += weight;
+                            }
+                        }
+                    }
+                    if (row - k >= 0)
+                    {
+                        int first = hit - k * BOARD_SIZE;
+                        const BoardMask& placement = tables.placements[size][SO_VERTICAL][first];
+
+                        if (!MaskIsEmpty(placement) && !MaskIntersects(placement, state.blockedMask))
+                        {
+                            for (int p = first; p < first + size * BOARD_SIZE; p += BOARD_SIZE)
+                            {
+                                scores[p] += weight;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    int cell = PickBestCell(scores, guessedMask);
+
+    if (cell < 0)
+    {
+        return GetRandomPosition();                                     // Board full, the game is already over
+    }
+    return CellToPosition(cell);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#ifndef __DENSITYAI_H__
+#define __DENSITYAI_H__
+
+#include "Game.h"
+
+/*
+    Probability-density AI. In hunt mode it fires at the unguessed cell covered by the most legal
+    placements of the ships still afloat. The per-cell counts live in Player::densityState and are
+    kept up to date from DensityStrategy's hooks (Strategy.h): a miss only touches the placements
+    through its cell, a sink recounts the board with the placement heatmap kernel (PlacementKernel.h).
+    Choosing a shot never re-enumerates the whole board. In target mode (unsunk hits on the board)
+    only the placements through those hits are scored.
+*/
+
+void ResetDensityState(Player& player);                                 // Fresh board, every ship of the player's fleet afloat
+void UpdateDensityOnMiss(DensityState& state, int cell);
+void UpdateDensityOnSunk(DensityState& state, const BoardMask& shipCells, int shipSize);
+ShipPositionType GetDensityGuess(const Player& aiPlayer);
+
+#endif
@@ -0,0 +1,556 @@
+// EndgameSolver.cpp : Expected-shots search over the fleets that still fit the board.
+//
+
+#include <iostream>
+#include <atomic>
+#include <cstring>
+#include "EndgameSolver.h"
+#include "FleetSampler.h"
+#include "Random.h"
+
+using namespace std;
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE,
+    MAX_HYPOTHESES = 64,                                                // Fleets, one bit each in a search state
+    MAX_SEARCH_HYPOTHESES = 12,                                         // Past this the search rarely finishes inside the budget
+    MAX_RAW_LAYOUTS = 50000,                                            // Skip listing fleets when the placement counts multiply past this
+    SEARCH_NODE_BUDGET = 20000,
+    TRANSPOSITION_BITS = 16,
+    TRANSPOSITION_SIZE = 1 << TRANSPOSITION_BITS
+};
+
+enum ZobristCellState
+{
+    ZC_MISSED = 0,
+    ZC_HIT,                                                             // Hit on a ship that is still afloat
+    ZC_SUNK,
+    NUM_ZOBRIST_CELL_STATES
+};
+
+struct ZobristKeys
+{
+    uint64_t cells[NUM_CELLS][NUM_ZOBRIST_CELL_STATES];
+    uint64_t afloat[1 << NUM_SHIPS];                                    // By sunkShipFlags
+};
+
+/*
+    Lock-free entry: check holds key ^ data, so an entry torn by two threads writing at once fails
+    the key comparison instead of returning the wrong value.
+*/
+struct TranspositionEntry
+{
+    atomic<uint64_t> check;
+    atomic<uint64_t> data;                                              // Expected shots as float bits, best cell above them, valid flag on top
+};
+
+struct EndgameHypothesis                                                // One way the afloat ships could lie
+{
+    BoardMask ships[NUM_SHIPS];                                         // Indexed like Player::ships, empty for ships sunk before the search
+    BoardMask cells;                                                    // All of the above
+};
+
+struct EndgameContext
+{
+    BoardMask blockedMask;
+    BoardMask openHits;
+    int shipSizes[NUM_SHIPS];                                           // Afloat ships
+    int shipIndices[NUM_SHIPS];                                         // Their index in Player::ships
+    int numShips;
+
+    EndgameHypothesis hypotheses[MAX_HYPOTHESES];
+    int numHypotheses;
+    uint64_t cellHypotheses[NUM_CELLS];                                 // Hypotheses with a ship on each cell
+    uint64_t cellShipHypotheses[NUM_CELLS][NUM_SHIPS];                  // The same, split by which ship it is
+
+    long long nodes;
+    bool isAborted;
+};
+
+static const uint64_t ENTRY_VALID = uint64_t(1) << 63;
+
+static TranspositionEntry transpositionTable[TRANSPOSITION_SIZE];
+
+static atomic<long long> totalAttempts(0);
+static atomic<long long> totalSolved(0);
+static atomic<long long> totalNodes(0);
+
+static ZobristKeys BuildZobristKeys()
+{
+    ZobristKeys keys;
+    RandomState random;
+
+    SeedRandom(random, 0x5A0B4157);                                     // Fixed, so keys mean the same thing on every run
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        for (int state = 0; state < NUM_ZOBRIST_CELL_STATES; state++)
+        {
+            keys.cells[cell][state] = NextRandom(random);
+        }
+    }
+    for (int flags = 0; flags < (1 << NUM_SHIPS); flags++)
+    {
+        keys.afloat[flags] = NextRandom(random);
+    }
+    return keys;
+}
+
+static const ZobristKeys& GetZobristKeys()
+{
+    static const ZobristKeys keys = BuildZobristKeys();                 // Built once, thread-safe static initialization
+
+    return keys;
+}
+
+static bool ProbeTransposition(uint64_t key, double& value, int& bestCell)
+{
+    TranspositionEntry& entry = transpositionTable[key & (TRANSPOSITION_SIZE - 1)];
+    uint64_t data = entry.data.load(memory_order_relaxed);
+    uint64_t check = entry.check.load(memory_order_relaxed);
+
+    if ((check ^ data) != key || !(data & ENTRY_VALID))
+    {
+        return false;
+    }
+
+    float stored;
+    uint32_t bits = uint32_t(data);
+
+    memcpy(&stored, &bits, sizeof(stored));
+    value = stored;
+    bestCell = int((data >> 32) & 0xFF);
+
+    return true;
+}
+
+static void StoreTransposition(uint64_t key, double value, int bestCell)
+{
+    TranspositionEntry& entry = transpositionTable[key & (TRANSPOSITION_SIZE - 1)];
+    float stored = float(value);
+    uint32_t bits;
+
+    memcpy(&bits, &stored, sizeof(bits));
+
+    uint64_t data = ENTRY_VALID | (uint64_t(bestCell) << 32) | bits;
+
+    entry.data.store(data, memory_order_relaxed);                       // Always replace
+    entry.check.store(key ^ data, memory_order_relaxed);
+}
+
+/*
+    Every way to lay the afloat ships that avoids blocked cells, covers all open hits and has no
+    ship sitting entirely on hits (that ship would already have been announced as sunk). Fleets are
+    kept ship by ship rather than as footprints: two fleets covering the same cells can still tell
+    themselves apart later, when one of their ships is announced as sunk.
+*/
+static void EnumerateFleets(EndgameContext& context, int ship, const BoardMask& occupied, EndgameHypothesis& fleet, int cellsLeft)
+{
+    if (context.isAborted)
+    {
+        return;
+    }
+
+    if (MaskPopCount(MaskAndNot(context.openHits, fleet.cells)) > cellsLeft)   // The ships left can't cover the hits left
+    {
+        return;
+    }
+
+    if (ship == context.numShips)
+    {
+        if (context.numHypotheses == MAX_HYPOTHESES)
+        {
+            context.isAborted = true;
+            return;
+        }
+
+        context.hypotheses[context.numHypotheses++] = fleet;
+        return;
+    }
+
+    BoardMask cells = fleet.cells;
+    int index = context.shipIndices[ship];
+
+    const ShipPlacement* placements;
+    int numPlacements = GetShipPlacements(context.shipSizes[ship], placements);
+
+    for (int i = 0; i < numPlacements && !context.isAborted; i++)
+    {
+        const BoardMask& mask = placements[i].mask;
+
+        if (MaskIntersects(mask, occupied) || MaskEquals(MaskAnd(mask, context.openHits), mask))
+        {
+            continue;
+        }
+
+        fleet.ships[index] = mask;
+        fleet.cells = MaskOr(cells, mask);
+
+        EnumerateFleets(context, ship + 1, MaskOr(occupied, mask), fleet, cellsLeft - context.shipSizes[ship]);
+    }
+
+    fleet.ships[index] = EmptyMask();
+    fleet.cells = cells;
+}
+
+static double SetChance(uint64_t subset, uint64_t set)                  // Every fleet is equally likely
+{
+    return double(PopCount64(subset)) / PopCount64(set);
+}
+
+static int ShipAt(const EndgameContext& context, int hypothesis, int cell)
+{
+    int ship = 0;
+
+    while (!((context.cellShipHypotheses[cell][ship] >> hypothesis) & 1))
+    {
+        ship++;
+    }
+    return ship;
+}
+
+/*
+    Key of the position after a shot at cell sinks ship, whose cells are shipCells: the ship's
+    earlier hits turn from hit to sunk, as in HashPosition.
+*/
+static uint64_t SinkKey(uint64_t key, int sunkFlags, int ship, const BoardMask& shipCells, int cell)
+{
+    const ZobristKeys& keys = GetZobristKeys();
+    BoardMask earlierHits = shipCells;
+
+    ClearCell(earlierHits, cell);
+    key ^= keys.afloat[sunkFlags] ^ keys.afloat[sunkFlags | (1 << ship)] ^ keys.cells[cell][ZC_SUNK];
+
+    for (int hit = MaskFirstCell(earlierHits); hit >= 0; hit = MaskFirstCell(earlierHits))
+    {
+        ClearCell(earlierHits, hit);
+        key ^= keys.cells[hit][ZC_HIT] ^ keys.cells[hit][ZC_SUNK];
+    }
+    return key;
+}
+
+/*
+    Expected shots to sink every remaining ship when the true fleet is one of the hypotheses in set,
+    all equally likely. shot holds every cell fired at so far and sunkFlags the ships announced sunk.
+
+    A shot splits set by what the game would answer: a miss, a hit, or a sink of one ship with its
+    cells. Each answer gets its own child whose key is the one HashPosition gives that position, and
+    whose set is exactly the fleets a fresh search from there would list, so a stored value always
+    means the same thing whichever search stored it.
+
+    Each hypothesis needs at least one shot per cell it has left, so the average of those counts
+    bounds the answer from below, and firing at a cell lowers that bound by exactly the chance of a
+    hit there. Trying cells in order of hit chance means the first cell whose bound can't beat the
+    best so far ends the loop.
+*/
+static double SearchEndgame(EndgameContext& context, uint64_t set, const BoardMask& shot, int sunkFlags, uint64_t key, int& bestCell)
+{
+    if ((set & (set - 1)) == 0)                                         // Known fleet: fire at its cells one by one
+    {
+        BoardMask left = MaskAndNot(context.hypotheses[CountTrailingZeros64(set)].cells, shot);
+
+        bestCell = MaskFirstCell(left);
+        return MaskPopCount(left);
+    }
+
+    double value;
+
+    if (ProbeTransposition(key, value, bestCell))
+    {
+        return value;
+    }
+
+    if (++context.nodes > SEARCH_NODE_BUDGET)
+    {
+        context.isAborted = true;
+        return 0;
+    }
+
+    const ZobristKeys& keys = GetZobristKeys();
+    double lowerBound = 0;
+    BoardMask candidates = EmptyMask();
+
+    for (uint64_t s = set; s != 0; s &= s - 1)
+    {
+        BoardMask left = MaskAndNot(context.hypotheses[CountTrailingZeros64(s)].cells, shot);
+
+        lowerBound += MaskPopCount(left);
+        candidates = MaskOr(candidates, left);                          // Cells no hypothesis covers are wasted shots
+    }
+
+    lowerBound /= PopCount64(set);
+
+    int order[NUM_CELLS];
+    double hitChance[NUM_CELLS];
+    int numCandidates = 0;
+
+    for (int cell = MaskFirstCell(candidates); cell >= 0; cell = MaskFirstCell(candidates))
+    {
+        ClearCell(candidates, cell);
+
+        bool isDuplicate = false;
+
+        for (int i = 0; i < numCandidates && !isDuplicate; i++)         // Cells on the same ship in every hypothesis are interchangeable
+        {
+            isDuplicate = true;
+
+            for (int ship = 0; ship < NUM_SHIPS && isDuplicate; ship++)
+            {
+                isDuplicate = (set & context.cellShipHypotheses[cell][ship]) == (set & context.cellShipHypotheses[order[i]][ship]);
+            }
+        }
+
+        if (isDuplicate)
+        {
+            continue;
+        }
+
+        double chance = SetChance(set & context.cellHypotheses[cell], set);
+        int i = numCandidates++;
+
+        for (; i > 0 && hitChance[i - 1] < chance; i--)                 // Insertion sort, most likely hit first
+        {
+            order[i] = order[i - 1];
+            hitChance[i] = hitChance[i - 1];
+        }
+
+        order[i] = cell;
+        hitChance[i] = chance;
+    }
+
+    double bestValue = 1e30;
+
+    bestCell = -1;
+
+    for (int i = 0; i < numCandidates; i++)
+    {
+        int cell = order[i];
+
+        if (1.0 + lowerBound - hitChance[i] >= bestValue)
+        {
+            break;
+        }
+
+        BoardMask nextShot = shot;
+        uint64_t hitSet = set & context.cellHypotheses[cell];
+        uint64_t missSet = set & ~context.cellHypotheses[cell];
+        uint64_t sinkSet = 0;
+        double cellValue = 1.0;
+        int unusedCell;
+
+        SetCell(nextShot, cell);
+
+        for (uint64_t s = hitSet; s != 0; s &= s - 1)
+        {
+            int h = CountTrailingZeros64(s);
+            const EndgameHypothesis& hypothesis = context.hypotheses[h];
+
+            if (MaskIsEmpty(MaskAndNot(hypothesis.cells, nextShot)))    // The last ship goes down, the game ends here
+            {
+                hitSet &= ~(uint64_t(1) << h);
+            }
+            else if (MaskIsEmpty(MaskAndNot(hypothesis.ships[ShipAt(context, h, cell)], nextShot)))
+            {
+                hitSet &= ~(uint64_t(1) << h);
+                sinkSet |= uint64_t(1) << h;
+            }
+        }
+
+        if (missSet != 0)
+        {
+            cellValue += SetChance(missSet, set) * SearchEndgame(context, missSet, nextShot, sunkFlags, key ^ keys.cells[cell][ZC_MISSED], unusedCell);
+        }
+        if (hitSet != 0 && cellValue < bestValue && !context.isAborted)
+        {
+            cellValue += SetChance(hitSet, set) * SearchEndgame(context, hitSet, nextShot, sunkFlags, key ^ keys.cells[cell][ZC_HIT], unusedCell);
+        }
+
+        while (sinkSet != 0 && cellValue < bestValue && !context.isAborted)   // One child per ship and placement that could be announced
+        {
+            int first = CountTrailingZeros64(sinkSet);
+            int ship = ShipAt(context, first, cell);
+            const BoardMask& shipCells = context.hypotheses[first].ships[ship];
+            uint64_t sameSink = 0;
+
+            for (uint64_t s = sinkSet; s != 0; s &= s - 1)
+            {
+                int h = CountTrailingZeros64(s);
+
+                if (MaskEquals(context.hypotheses[h].ships[ship], shipCells))
+                {
+                    sameSink |= uint64_t(1) << h;
+                }
+            }
+
+            sinkSet &= ~sameSink;
+            cellValue += SetChance(sameSink, set) * SearchEndgame(context, sameSink, nextShot, sunkFlags | (1 << ship), SinkKey(key, sunkFlags, ship, shipCells, cell), unusedCell);
+        }
+
+        if (context.isAborted)
+        {
+            return 0;
+        }
+
+        if (cellValue < bestValue)
+        {
+            bestValue = cellValue;
+            bestCell = cell;
+        }
+    }
+
+    StoreTransposition(key, bestValue, bestCell);                       // Only complete results are stored
+
+    return bestValue;
+}
+
+static uint64_t HashPosition(const Player& aiPlayer)
+{
+    const ZobristKeys& keys = GetZobristKeys();
+    uint64_t key = keys.afloat[aiPlayer.sunkShipFlags];
+    BoardMask guessed = MaskOr(aiPlayer.guessHitMask, aiPlayer.guessMissMask);
+
+    for (int cell = MaskFirstCell(guessed); cell >= 0; cell = MaskFirstCell(guessed))
+    {
+        ClearCell(guessed, cell);
+
+        if (TestCell(aiPlayer.guessMissMask, cell))
+        {
+            key ^= keys.cells[cell][ZC_MISSED];
+        }
+        else
+        {
+            key ^= keys.cells[cell][TestCell(aiPlayer.guessSunkMask, cell) ? ZC_SUNK : ZC_HIT];
+        }
+    }
+    return key;
+}
+
+bool SolveEndgame(const Player& aiPlayer, ShipPositionType& guess)
+{
+    EndgameContext context;
+    BoardMask guessed = MaskOr(aiPlayer.guessHitMask, aiPlayer.guessMissMask);
+    double rawLayouts = 1;
+    int cellsLeft = 0;
+
+    totalAttempts++;
+
+    context.blockedMask = MaskOr(aiPlayer.guessMissMask, aiPlayer.guessSunkMask);
+    context.openHits = MaskAndNot(aiPlayer.guessHitMask, aiPlayer.guessSunkMask);
+    context.numShips = 0;
+    context.numHypotheses = 0;
+    context.nodes = 0;
+    context.isAborted = false;
+
+    for (int i = 0; i < NUM_SHIPS; i++)                                 // Both fleets have the same make-up
+    {
+        if (aiPlayer.sunkShipFlags & (1 << i))
+        {
+            continue;
+        }
+
+        int size = aiPlayer.ships[i].shipSize;
+        const ShipPlacement* placements;
+        int numPlacements = GetShipPlacements(size, placements);
+        int numLegal = 0;
+
+        for (int p = 0; p < numPlacements; p++)
+        {
+            numLegal += !MaskIntersects(placements[p].mask, context.blockedMask);
+        }
+
+        rawLayouts *= numLegal;
+        cellsLeft += size;
+        context.shipSizes[context.numShips] = size;
+        context.shipIndices[context.numShips++] = i;
+    }
+
+    if (context.numShips == 0 || rawLayouts > MAX_RAW_LAYOUTS)          // Too early in the game to list every fleet
+    {
+        return false;
+    }
+
+    EndgameHypothesis fleet;
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        fleet.ships[i] = EmptyMask();
+    }
+    fleet.cells = EmptyMask();
+
+    EnumerateFleets(context, 0, context.blockedMask, fleet, cellsLeft);
+
+    if (context.isAborted || context.numHypotheses == 0 || context.numHypotheses > MAX_SEARCH_HYPOTHESES)
+    {
+        return false;
+    }
+
+    memset(context.cellHypotheses, 0, sizeof(context.cellHypotheses));
+    memset(context.cellShipHypotheses, 0, sizeof(context.cellShipHypotheses));
+
+    for (int h = 0; h < context.numHypotheses; h++)
+    {
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            BoardMask cells = context.hypotheses[h].ships[ship];
+
+            for (int cell = MaskFirstCell(cells); cell >= 0; cell = MaskFirstCell(cells))
+            {
+                ClearCell(cells, cell);
+                context.cellHypotheses[cell] |= uint64_t(1) << h;
+                context.cellShipHypotheses[cell][ship] |= uint64_t(1) << h;
+            }
+        }
+    }
+
+    uint64_t all = context.numHypotheses == 64 ? ~uint64_t(0) : (uint64_t(1) << context.numHypotheses) - 1;
+    int bestCell;
+
+    SearchEndgame(context, all, guessed, aiPlayer.sunkShipFlags, HashPosition(aiPlayer), bestCell);
+
+    totalNodes += context.nodes;
+
+    if (context.isAborted || bestCell < 0 || TestCell(guessed, bestCell))
+    {
+        return false;
+    }
+
+    totalSolved++;
+
+    guess.row = bestCell / BOARD_SIZE;
+    guess.col = bestCell % BOARD_SIZE;
+
+    return true;
+}
+
+void ResetEndgameStats()
+{
+    totalAttempts = 0;
+    totalSolved = 0;
+    totalNodes = 0;
+}
+
+EndgameStats GetEndgameStats()
+{
+    EndgameStats stats;
+
+    stats.attempts = totalAttempts;
+    stats.solved = totalSolved;
+    stats.nodes = totalNodes;
+
+    return stats;
+}
+
+void PrintEndgameStats()
+{
+    EndgameStats stats = GetEndgameStats();
+
+    if (stats.attempts == 0)
+    {
+        return;
+    }
+
+    cout << endl << "Endgame solver" << endl;
+    cout << "Moves solved:   " << stats.solved << " of " << stats.attempts << endl;
+    cout << "Search nodes:   " << stats.nodes << " (avg " << double(stats.nodes) / stats.attempts << " per move)" << endl;
+}
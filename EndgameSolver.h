@@ -0,0 +1,32 @@
+#pragma once
+
+#ifndef __ENDGAMESOLVER_H__
+#define __ENDGAMESOLVER_H__
+
+#include "Game.h"
+
+/*
+    Exact endgame play. Once the fleets that still fit the board are few enough to list, the solver
+    searches every sequence of shots for the one with the fewest expected shots to finish the game,
+    with every remaining fleet equally likely. It branches on the answers the game would give,
+    misses, hits and the announcement of which ship sank where, so each search position is exactly
+    the position a player would see. Positions are keyed by a Zobrist hash of the guesses,
+    the sunk cells and the set of ships still afloat, and solved values go into a fixed-size
+    transposition table shared lock-free by all threads. The search gives up once it has visited
+    its node budget, so a move never costs more than that.
+*/
+
+struct EndgameStats                                                     // Totals since the last reset
+{
+    long long attempts;                                                 // Moves the solver was asked about
+    long long solved;                                                   // Moves it answered exactly
+    long long nodes;                                                    // Search nodes visited, including abandoned searches
+};
+
+bool SolveEndgame(const Player& aiPlayer, ShipPositionType& guess);     // False if too many fleets remain or the budget ran out
+
+void ResetEndgameStats();
+EndgameStats GetEndgameStats();
+void PrintEndgameStats();
+
+#endif
@@ -0,0 +1,30 @@
+// FleetSampler.cpp : Random fleet placement from precomputed placement lists.
+//
+
+#include "FleetSampler.h"
+
+int GetShipPlacements(int shipSize, const ShipPlacement*& placements)
+{
+    const ClassicGame::PlacementTables& tables = ClassicGame::GetPlacementTables();
+
+    placements = tables.placements[shipSize];
+    return tables.numPlacements[shipSize];
+}
+
+bool SampleShipPlacement(RandomState& random, const BoardMask& blockedMask, int shipSize, ShipPlacement& placement)
+{
+    return ClassicGame::SampleShipPlacement(random, blockedMask, shipSize, placement);
+}
+
+void GenerateRandomFleet(RandomState& random, FleetLayout& fleet)
+{
+    ClassicGame::GenerateRandomFleet(random, fleet);
+}
+
+void GenerateRandomFleets(RandomState& random, FleetLayout fleets[], int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        GenerateRandomFleet(random, fleets[i]);
+    }
+}
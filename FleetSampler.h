@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef __FLEETSAMPLER_H__
+#define __FLEETSAMPLER_H__
+
+#include "Game.h"
+#include "Random.h"
+
+/*
+    Random ship placement without open-ended retries, for the classic board. Every placement that
+    fits on an empty board is listed once per ship size; a ship is placed by drawing from that list
+    and rejecting draws that cover a blocked cell. After a few rejected draws the legal placements
+    are gathered and one is picked directly, so a ship never costs more than a short scan of its
+    list. Either way every legal placement is equally likely.
+
+    The lists and the sampler are ClassicGame's (BoardGame.h), the same code the other board
+    variants place their fleets with.
+*/
+
+enum
+{
+    MAX_SHIP_PLACEMENTS = ClassicGame::MAX_PLACEMENTS                   // Upper bound on placements of one ship on an empty board
+};
+
+typedef ClassicGame::Placement ShipPlacement;                           // Cells covered, row, col and ShipOrientationType
+typedef ClassicGame::FleetLayout FleetLayout;                           // A whole fleet, ships in the order InitializePlayer creates them
+
+int GetShipPlacements(int shipSize, const ShipPlacement*& placements);   // Every placement of that size on an empty board, returns how many
+bool SampleShipPlacement(RandomState& random, const BoardMask& blockedMask, int shipSize, ShipPlacement& placement);    // False if nothing fits
+void GenerateRandomFleet(RandomState& random, FleetLayout& fleet);
+void GenerateRandomFleets(RandomState& random, FleetLayout fleets[], int count);   // Bulk version for Monte Carlo use
+
+#endif
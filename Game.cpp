@@ -0,0 +1,527 @@
+// Game.cpp : Board and rule functions shared by the console game and the headless simulations.
+//
+
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+#include "Game.h"
+#include "Random.h"
+#include "FleetSampler.h"
+#include "Strategy.h"
+
+/* Player/Ship Initializations functions */
+
+void InitializePlayer(Player& player, const char* playerName)
+{
+    if (playerName != nullptr && strlen(playerName) > 0)
+    {
+#ifdef _WIN32
+        strcpy_s(player.playerName, playerName);
+#else
+        snprintf(player.playerName, sizeof(player.playerName), "%s", playerName);   // strcpy_s is Microsoft only
+#endif
+    }
+
+    player.playerType = PT_HUMAN;                                       // No strategy hooks until the caller makes it an AI
+    player.aiStrategy = AI_RANDOM;
+    player.boardBackend = BB_BITBOARD;
+
+    ResetShotPool(player.shotPool);                                     // Valid from the start, not only after ClearBoards of a random AI
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        InitializeShip(player.ships[i], ClassicFleet::ShipSize(i), ShipType(i + 1));
+    }
+}
+
+void InitializeShip(Ship& ship, int shipSize, ShipType shipType)
+{
+    ship.shipType = shipType;
+    ship.shipSize =shipSize;
+    ship.shipPosition.row = 0;
+    ship.shipPosition.col = 0;
+    ship.shipOrientation = SO_HORIZONTAL;
+}
+
+/* End of Player/Ship Initializations functions */
+
+/* Game Functions */
+
+ShipType UpdateBoards(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer)
+{
+    ShipType shipType = ResolveShot(guess, currentPlayer, otherPlayer);
+
+    if (currentPlayer.playerType == PT_AI)                              // A human's aiStrategy is not in play, ClearBoards never set up its state
+    {
+        NotifyShot(GetStrategy(currentPlayer.aiStrategy), currentPlayer, otherPlayer, guess, shipType);
+    }
+
+    return shipType;
+}
+
+ShipType ResolveShot(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer)
+{
+    int cell = CellIndex(guess.row, guess.col);
+    ShipType shipType = ST_NONE;
+
+    if (otherPlayer.boardBackend == BB_BITBOARD)
+    {
+        if (TestCell(otherPlayer.occupiedMask, cell))
+        {
+            for (int i = 0; i < NUM_SHIPS; i++)
+            {
+                if (TestCell(otherPlayer.shipMasks[i], cell))
+                {
+                    shipType = otherPlayer.ships[i].shipType;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        shipType = otherPlayer.shipBoard[guess.row][guess.col].shipType;
+
+        if (shipType != ST_NONE)
+        {
+            otherPlayer.shipBoard[guess.row][guess.col].isHit = true;
+        }
+    }
+
+    if (shipType != ST_NONE)                                            // The masks are kept for both backends, the AI reads them
+    {
+        if (!TestCell(otherPlayer.damageMask, cell) && ++otherPlayer.shipHits[shipType - 1] == otherPlayer.ships[shipType - 1].shipSize)
+        {
+            otherPlayer.shipsRemaining--;
+        }
+
+        SetCell(otherPlayer.damageMask, cell);
+    }
+
+    if (shipType != ST_NONE && IsSunk(otherPlayer, otherPlayer.ships[shipType - 1]))   // The game announces sinks, so the shooter may know the cells
+    {
+        ApplyShotOutcome(currentPlayer, guess, true, shipType, otherPlayer.shipMasks[shipType - 1]);
+    }
+    else
+    {
+        ApplyShotOutcome(currentPlayer, guess, shipType != ST_NONE, ST_NONE, EmptyMask());
+    }
+
+    return shipType;
+}
+
+void ApplyShotOutcome(Player& currentPlayer, ShipPositionType guess, bool isHit, ShipType sunkShip, const BoardMask& sunkCells)
+{
+    int cell = CellIndex(guess.row, guess.col);
+
+    if (isHit)
+    {
+        SetCell(currentPlayer.guessHitMask, cell);
+    }
+    else
+    {
+        SetCell(currentPlayer.guessMissMask, cell);
+    }
+
+    if (currentPlayer.boardBackend == BB_ARRAY)
+    {
+        currentPlayer.guessBoard[guess.row][guess.col] = isHit ? GT_HIT : GT_MISSED;
+    }
+
+    if (sunkShip != ST_NONE)
+    {
+        currentPlayer.guessSunkMask = MaskOr(currentPlayer.guessSunkMask, sunkCells);
+        currentPlayer.sunkShipFlags |= (unsigned char)(1 << (sunkShip - 1));
+    }
+}
+
+bool IsGameOver(const Player& player1, const Player& player2)
+{
+    return AreAllShipsSunk(player1) || AreAllShipsSunk(player2);
+}
+
+bool AreAllShipsSunk(const Player& player)
+{
+    assert(AreAllShipsSunkScan(player) == (player.shipsRemaining == 0));
+
+    return player.shipsRemaining == 0;
+}
+
+bool IsSunk(const Player& player, const Ship& ship)
+{
+    bool isSunk = player.shipHits[ship.shipType - 1] >= ship.shipSize;
+
+    assert(IsSunkScan(player, ship) == isSunk);
+
+    return isSunk;
+}
+
+bool AreAllShipsSunkScan(const Player& player)
+{
+    if (player.boardBackend == BB_BITBOARD)
+    {
+        return MaskIsEmpty(MaskAndNot(player.occupiedMask, player.damageMask));
+    }
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        if (!IsSunkScan(player, player.ships[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsSunkScan(const Player& player, const Ship& ship)
+{
+    if (player.boardBackend == BB_BITBOARD)
+    {
+        const BoardMask& shipMask = player.shipMasks[ship.shipType - 1];
+
+        return MaskEquals(MaskAnd(shipMask, player.damageMask), shipMask);
+    }
+
+    if (ship.shipOrientation == SO_HORIZONTAL)
+    {
+        for (int col = ship.shipPosition.col; col < (ship.shipPosition.col + ship.shipSize); col++)
+        {
+            if (!player.shipBoard[ship.shipPosition.row][col].isHit)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        for (int row = ship.shipPosition.row; row < (ship.shipPosition.row + ship.shipSize); row++)
+        {
+            if (!player.shipBoard[row][ship.shipPosition.col].isHit)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void SwitchPlayers(Player** currentPlayer, Player** otherPlayer)
+{
+    Player* temp = *currentPlayer;
+    *currentPlayer = *otherPlayer;
+    *otherPlayer = temp;
+}
+
+ShipPositionType GetRandomPosition()
+{
+    ShipPositionType guess;
+
+    RandomState& random = GetThreadRandom();
+
+    guess.row = RandomInt(random, BOARD_SIZE);
+    guess.col = RandomInt(random, BOARD_SIZE);
+
+    return guess;
+}
+
+/*
+    The pool is a Fisher-Yates shuffle done one shot at a time: a cell that is fired at swaps places
+    with the first open one and the open part shrinks by one. Drawing and removing are separate so
+    that choosing a shot leaves the player untouched, the strategy's hit and miss hooks remove it.
+*/
+ShipPositionType DrawFromShotPool(const ShotPool& pool)
+{
+    int cell = DrawFromCellPool(pool, GetThreadRandom());
+
+    if (cell < 0)
+    {
+        return GetRandomPosition();                                     // Board full, the game is already over
+    }
+
+    ShipPositionType guess;
+
+    guess.row = cell / BOARD_SIZE;
+    guess.col = cell % BOARD_SIZE;
+
+    return guess;
+}
+
+void RemoveFromShotPool(ShotPool& pool, int cell)
+{
+    RemoveFromCellPool(pool, cell);
+}
+
+ShipPositionType GetAIGuess(const Player& aiPlayer)
+{
+    return GetStrategy(aiPlayer.aiStrategy).ChooseShot(aiPlayer);
+}
+
+const char* GetAIStrategyName(AIStrategyType strategy)
+{
+    switch (strategy)
+    {
+    case AI_RANDOM:
+        return "random";
+    case AI_DENSITY:
+        return "density";
+    case AI_MONTE_CARLO:
+        return "montecarlo";
+    case AI_ENDGAME:
+        return "endgame";
+    case AI_PARITY:
+        return "parity";
+    default:
+        return "unknown";
+    }
+}
+
+bool ParseAIStrategy(const char* name, AIStrategyType& strategy)
+{
+    for (int i = 0; i < NUM_AI_STRATEGIES; i++)
+    {
+        if (strcmp(name, GetAIStrategyName(AIStrategyType(i))) == 0)
+        {
+            strategy = AIStrategyType(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* End of Game Functions */
+
+/* Board Functions */
+
+void ClearBoards(Player& player)
+{
+    static_assert(GT_NONE == 0 && ST_NONE == 0, "The cleared arrays are all zero bytes");
+
+    if (player.boardBackend == BB_ARRAY)                                // The bitboard backend never touches the arrays
+    {
+        memset(player.guessBoard, 0, sizeof(player.guessBoard));
+        memset(player.shipBoard, 0, sizeof(player.shipBoard));
+    }
+
+    player.occupiedMask = EmptyMask();
+    player.damageMask = EmptyMask();
+    player.guessHitMask = EmptyMask();
+    player.guessMissMask = EmptyMask();
+    player.guessSunkMask = EmptyMask();
+    player.sunkShipFlags = 0;
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        player.shipMasks[i] = EmptyMask();
+        player.shipHits[i] = 0;
+    }
+
+    player.shipsRemaining = NUM_SHIPS;
+
+    if (player.playerType == PT_AI)                                     // The same test UpdateBoards makes before it runs the hooks
+    {
+        GetStrategy(player.aiStrategy).ResetState(player);              // Only the state this strategy reads, the others are hundreds of bytes
+    }
+}
+
+static ShotPool MakeFullShotPool()
+{
+    ShotPool pool;
+
+    FillCellPool(pool);
+    return pool;
+}
+
+static const ShotPool fullShotPool = MakeFullShotPool();
+
+void ResetShotPool(ShotPool& pool)
+{
+    pool = fullShotPool;                                                // One 204 byte copy, ClearBoards runs once per game
+}
+
+void SetupAIBoards(Player& player)
+{
+    FleetLayout fleet;
+
+    GenerateRandomFleet(GetThreadRandom(), fleet);
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        ShipPositionType pos;
+
+        pos.row = fleet.ships[i].row;
+        pos.col = fleet.ships[i].col;
+
+        assert(player.ships[i].shipSize == MaskPopCount(fleet.ships[i].mask));
+
+        PlaceShipOnBoard(player, player.ships[i], pos, ShipOrientationType(fleet.ships[i].orientation));
+    }
+}
+
+/* End of Board Functions */
+
+/* Board Query Functions */
+
+GuessType GetGuessAt(const Player& player, int row, int col)
+{
+    if (player.boardBackend == BB_ARRAY)
+    {
+        return player.guessBoard[row][col];
+    }
+
+    int cell = CellIndex(row, col);
+
+    if (TestCell(player.guessHitMask, cell))
+    {
+        return GT_HIT;
+    }
+    else if (TestCell(player.guessMissMask, cell))
+    {
+        return GT_MISSED;
+    }
+    return GT_NONE;
+}
+
+ShipType GetShipTypeAt(const Player& player, int row, int col)
+{
+    if (player.boardBackend == BB_ARRAY)
+    {
+        return player.shipBoard[row][col].shipType;
+    }
+
+    int cell = CellIndex(row, col);
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        if (TestCell(player.shipMasks[i], cell))
+        {
+            return player.ships[i].shipType;
+        }
+    }
+    return ST_NONE;
+}
+
+bool IsShipPartHitAt(const Player& player, int row, int col)
+{
+    if (player.boardBackend == BB_ARRAY)
+    {
+        return player.shipBoard[row][col].isHit;
+    }
+
+    return TestCell(player.damageMask, CellIndex(row, col));
+}
+
+/* End of Board Query Functions */
+
+/* Placement Functions */
+
+const char* GetShipNameForShipType(ShipType shipType)
+{
+    if (shipType == ST_AIRCRAFT_CARRIER)
+    {
+        return "Aircraft Carrier";
+    }
+    else if(shipType == ST_BATTLESHIP)
+    {
+        return "Battleship";
+    }
+    else if(shipType == ST_CRUISER)
+    {
+        return "Cruiser";
+    }
+    else if (shipType == ST_DESTROYER)
+    {
+        return "Destroyer";
+    }
+    else if (shipType == ST_SUBMARINE)
+    {
+        return "Submarine";
+    }
+
+    return "None";
+}
+
+ShipPositionType MapBoardPosition(char rowInput, int colInput)
+{
+    int realRow = rowInput - 'A';
+    int realCol = colInput - 1;
+
+    ShipPositionType boardPosition;
+
+    boardPosition.row = realRow;
+    boardPosition.col = realCol;
+
+    return boardPosition;
+}
+
+bool IsValidPlacement(const Player& player, const Ship& currentShip, const ShipPositionType shipPosition, ShipOrientationType orientation)
+{
+    if (player.boardBackend == BB_BITBOARD)
+    {
+        int end = (orientation == SO_HORIZONTAL ? shipPosition.col : shipPosition.row) + currentShip.shipSize;
+
+        if (end > BOARD_SIZE)
+        {
+            return false;
+        }
+
+        return !MaskIntersects(player.occupiedMask, LineMask(shipPosition.row, shipPosition.col, currentShip.shipSize, orientation == SO_VERTICAL));
+    }
+
+    if (orientation == SO_HORIZONTAL)
+    {
+        for (int c = shipPosition.col; c < (shipPosition.col + currentShip.shipSize); c++)
+        {
+            if (c >= BOARD_SIZE || player.shipBoard[shipPosition.row][c].shipType != ST_NONE)
+            {
+                return false;
+            }
+        }
+    }
+    else {
+        for (int r = shipPosition.row; r < (shipPosition.row + currentShip.shipSize); r++)
+        {
+            if (r >= BOARD_SIZE || player.shipBoard[r][shipPosition.col].shipType != ST_NONE)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void PlaceShipOnBoard(Player& player, Ship& currentShip, const ShipPositionType shipPosition, const ShipOrientationType orientation)
+{
+    currentShip.shipPosition = shipPosition;
+    currentShip.shipOrientation = orientation;
+
+    BoardMask shipMask = LineMask(shipPosition.row, shipPosition.col, currentShip.shipSize, orientation == SO_VERTICAL);
+
+    player.shipMasks[currentShip.shipType - 1] = shipMask;
+    player.occupiedMask = MaskOr(player.occupiedMask, shipMask);
+
+    if (player.boardBackend == BB_BITBOARD)
+    {
+        return;
+    }
+
+    if (orientation == SO_HORIZONTAL)
+    {
+        for (int c = shipPosition.col; c < (shipPosition.col + currentShip.shipSize); c++)
+        {
+            player.shipBoard[shipPosition.row][c].shipType = currentShip.shipType;
+            player.shipBoard[shipPosition.row][c].isHit = false;
+        }
+    }
+    else
+    {
+        for (int r = shipPosition.row; r < (shipPosition.row + currentShip.shipSize); r++)
+        {
+            player.shipBoard[r][shipPosition.col].shipType = currentShip.shipType;
+            player.shipBoard[r][shipPosition.col].isHit = false;
+        }
+    }
+}
+
+/* End of Placement Functions */
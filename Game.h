@@ -0,0 +1,183 @@
+#pragma once
+
+#ifndef __GAME_H__
+#define __GAME_H__
+
+#include "BoardMask.h"
+#include "BoardGame.h"
+
+/* Enums */
+
+enum                                                                    // The board and fleet of ClassicGame (BoardGame.h), the game everything here plays
+{
+    AIRCRAFT_CARRIER_SIZE = ClassicFleet::ShipSize(0),
+    BATTLESHIP_SIZE = ClassicFleet::ShipSize(1),
+    CRUISER_SIZE = ClassicFleet::ShipSize(2),
+    DESTROYER_SIZE = ClassicFleet::ShipSize(3),
+    SUBMARINE_SIZE = ClassicFleet::ShipSize(4),
+
+    BOARD_SIZE = ClassicGame::ROWS,
+    NUM_SHIPS = ClassicGame::NUM_SHIPS,
+    PLAYER_NAME_SIZE = 8,                                               // Player1, Player2
+    MAX_SHIP_SIZE = ClassicGame::MAX_SHIP_SIZE
+};
+
+static_assert(ClassicGame::ROWS == ClassicGame::COLS, "The boards, prompts and log cells assume a square board");
+static_assert(ClassicGame::COLS == BOARD_MASK_STRIDE && ClassicGame::CELLS <= BOARD_MASK_CELLS, "Player masks index cells as row * BOARD_MASK_STRIDE + col");
+ 
+enum ShipType                                                           // Type of ship enum to simplify shiptypes to a number
+{
+    ST_NONE = 0,
+    ST_AIRCRAFT_CARRIER,
+    ST_BATTLESHIP,
+    ST_CRUISER,
+    ST_DESTROYER,
+    ST_SUBMARINE
+};
+
+static_assert(int(ST_SUBMARINE) == int(NUM_SHIPS), "One ShipType per ship of ClassicFleet, in the same order");
+            
+enum ShipOrientationType                                                 // Orientation enum to define horizontal and vertical direction of ships 
+{
+    SO_HORIZONTAL = 0,
+    SO_VERTICAL
+};
+
+enum GuessType                                                           // Type of guess the player makes, only three types
+{
+    GT_NONE = 0,
+    GT_MISSED,
+    GT_HIT
+};
+
+enum PlayerType
+{
+    PT_HUMAN = 0,
+    PT_AI
+};
+
+enum AIStrategyType                                                      // How an AI player picks its shots
+{
+    AI_RANDOM = 0,
+    AI_DENSITY,                                                         // Fire where the most legal placements of the remaining ships overlap
+    AI_MONTE_CARLO,                                                     // Fire where sampled fleets consistent with the board overlap most
+    AI_ENDGAME,                                                         // Density until few fleets remain, then exact expected-shots search
+    AI_PARITY,                                                          // Checkerboard hunt on the smallest ship's spacing, then fire around hits
+    NUM_AI_STRATEGIES
+};
+
+enum BoardBackendType                                                    // Which board layout answers the board queries
+{
+    BB_ARRAY = 0,                                                       // 2D guessBoard/shipBoard arrays, scanned cell by cell
+    BB_BITBOARD                                                         // 128-bit masks, queried with ANDs and popcounts
+};
+
+/* Structs */
+
+struct ShipPositionType                                                 // The position coordinates of the ship on the board
+{
+    int row;
+    int col;
+};
+
+struct ShipPartType                                                     // The board spot state
+{
+    ShipType shipType;
+    bool isHit;
+};
+
+struct Ship                                                             // Ship struct defining ship data 
+{
+    ShipType shipType;
+    int shipSize;
+    ShipOrientationType shipOrientation;
+    ShipPositionType shipPosition;
+};
+
+struct DensityState                                                     // What the density AI knows about the other player's fleet
+{
+    unsigned char shipsAfloat[MAX_SHIP_SIZE + 1];                       // Unsunk enemy ships of each size
+    short density[BOARD_SIZE * BOARD_SIZE];                             // Legal placements over each cell, one count per ship afloat
+    BoardMask blockedMask;                                              // Misses plus the cells of sunk ships
+};
+
+struct ParityState                                                      // The parity AI's candidate cells, updated shot by shot
+{
+    unsigned char shipsAfloat[MAX_SHIP_SIZE + 1];                       // Unsunk enemy ships of each size
+    int huntSpacing;                                                    // Size of the smallest ship afloat
+    BoardMask huntMask;                                                 // Unguessed cells with (row + col) % huntSpacing == 0
+    BoardMask frontierMask;                                             // Unguessed neighbours of liveHitMask
+    BoardMask liveHitMask;                                              // Hits on ships not sunk yet
+};
+
+typedef ClassicGame::ShotPool ShotPool;                                 // The cells a player has not fired at, for the random AI
+
+struct Player                                                           // Player struct defining player data
+{
+    PlayerType playerType;
+    AIStrategyType aiStrategy;
+    BoardBackendType boardBackend;
+    char playerName[PLAYER_NAME_SIZE];
+    Ship ships[NUM_SHIPS];
+    GuessType guessBoard[BOARD_SIZE][BOARD_SIZE];                       // Only written with the BB_ARRAY backend
+    ShipPartType shipBoard[BOARD_SIZE][BOARD_SIZE];                     // Only written with the BB_ARRAY backend
+
+    BoardMask occupiedMask;                                             // Every cell covered by one of our ships
+    BoardMask damageMask;                                               // Cells of our ships the other player has hit
+    BoardMask shipMasks[NUM_SHIPS];                                     // Cells of each ship, indexed like ships[]
+    BoardMask guessHitMask;                                             // Our guesses that hit
+    BoardMask guessMissMask;                                            // Our guesses that missed
+    BoardMask guessSunkMask;                                            // Cells of the other player's ships we have sunk
+    unsigned char sunkShipFlags;                                        // Bit i set once the other player's ships[i] is sunk
+
+    unsigned char shipHits[NUM_SHIPS];                                  // Hits taken by each ship, indexed like ships[]
+    int shipsRemaining;                                                 // Ships not yet sunk
+
+    DensityState densityState;                                          // Only kept up to date for AI_DENSITY and AI_ENDGAME players
+    ShotPool shotPool;                                                  // Only kept up to date for AI_RANDOM players
+    ParityState parityState;                                            // Only kept up to date for AI_PARITY players
+};
+
+/* Initializations for player and ships */
+
+void InitializePlayer(Player& player, const char* playerName);          // Initialize the player function
+void InitializeShip(Ship& ship, int shipSize, ShipType shipType);       // Initialize the ship function
+
+/* Game functions, none of these touch the terminal */
+
+ShipType UpdateBoards(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer);   // ResolveShot, then the strategy hooks if an AI fired
+ShipType ResolveShot(ShipPositionType guess, Player& currentPlayer, Player& otherPlayer);    // The rules alone, see NotifyShot in Strategy.h
+void ApplyShotOutcome(Player& currentPlayer, ShipPositionType guess, bool isHit, ShipType sunkShip, const BoardMask& sunkCells);   // The shooter's side of a shot, for when only the answer is known; sunkShip is ST_NONE unless it sank
+bool IsGameOver(const Player& player1, const Player& player2);
+bool AreAllShipsSunk(const Player& player);
+bool IsSunk(const Player& player, const Ship& ship);                    // Constant time, from the hit counters UpdateBoards keeps
+bool AreAllShipsSunkScan(const Player& player);                         // Reference versions that look at the board itself
+bool IsSunkScan(const Player& player, const Ship& ship);
+void SwitchPlayers(Player** currentPlayer, Player** otherPlayer);
+ShipPositionType GetAIGuess(const Player& aiPlayer);
+ShipPositionType GetRandomPosition();
+ShipPositionType DrawFromShotPool(const ShotPool& pool);                // A uniform pick among the open cells, left in the pool
+void RemoveFromShotPool(ShotPool& pool, int cell);                      // Constant time, cells already fired at are ignored
+const char* GetAIStrategyName(AIStrategyType strategy);
+bool ParseAIStrategy(const char* name, AIStrategyType& strategy);
+
+/* Board functions */
+
+void ClearBoards(Player& player);                                       // Clear boards for starting new games
+void ResetShotPool(ShotPool& pool);                                     // Every cell open
+void SetupAIBoards(Player& player);                                     // Random fleet, the default placement hook of every strategy
+
+/* Board query functions, these answer from whichever backend the player uses */
+
+GuessType GetGuessAt(const Player& player, int row, int col);
+ShipType GetShipTypeAt(const Player& player, int row, int col);
+bool IsShipPartHitAt(const Player& player, int row, int col);
+
+/* Placement of ship functions */
+
+const char* GetShipNameForShipType(ShipType shipType);
+ShipPositionType MapBoardPosition(char rowInput, int colInput);
+bool IsValidPlacement(const Player& player, const Ship& currentShip, const ShipPositionType shipPosition, ShipOrientationType orientation);
+void PlaceShipOnBoard(Player& player, Ship& currentShip, const ShipPositionType shipPosition, const ShipOrientationType orientation);
+
+#endif
@@ -0,0 +1,257 @@
+// GameAnalytics.cpp : Parallel scans of memory-mapped game logs.
+//
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include "GameAnalytics.h"
+#include "GameLog.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+enum
+{
+    ANALYTICS_GRAIN_SIZE = 16                                           // Blocks a thread takes at a time, 256 KB
+};
+
+struct alignas(64) GameLogAccumulator                                   // Written by one thread only, summed after the scan
+{
+    long long games;
+    long long damagedGames;
+    long long strategyGames[NUM_AI_STRATEGIES];
+    long long strategyWins[NUM_AI_STRATEGIES];
+    long long shotHistogram[MAX_GAME_TURNS + 1];
+    long long firstHits[BOARD_SIZE * BOARD_SIZE];
+    long long sinkOrder[NUM_SHIPS][NUM_SHIPS];
+};
+
+struct GameLogScan
+{
+    const unsigned char* logData;
+};
+
+static GameLogAccumulator accumulators[MAX_POOL_THREADS];               // Static storage keeps the 64 byte alignment
+
+static void AccumulateRecord(GameLogAccumulator& total, GameRecordView record)
+{
+    int winner = GetRecordWinner(record);
+    int numShots = GetRecordShotCount(record);
+    signed char shipAt[2][BOARD_SIZE * BOARD_SIZE];                     // Ship index on each cell of each fleet, -1 for water
+    unsigned char shipHits[2][NUM_SHIPS] = {};
+    int sunkCount[2] = { 0, 0 };
+    bool hasHit[2] = { false, false };
+
+    total.games++;
+
+    for (int player = 0; player < 2; player++)
+    {
+        AIStrategyType strategy = GetRecordStrategy(record, player);
+
+        if (strategy < NUM_AI_STRATEGIES)
+        {
+            total.strategyGames[strategy]++;
+            total.strategyWins[strategy] += winner == player;
+        }
+
+        memset(shipAt[player], -1, sizeof(shipAt[player]));
+
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            int cell = GetRecordShipCell(record, player, ship);
+            int step = GetRecordShipOrientation(record, player, ship) == SO_VERTICAL ? BOARD_SIZE : 1;
+
+            for (int k = 0; k < ClassicFleet::ShipSize(ship); k++, cell += step)
+            {
+                shipAt[player][cell] = (signed char)ship;
+            }
+        }
+    }
+
+    total.shotHistogram[numShots]++;
+
+    for (int shot = 0; shot < numShots; shot++)
+    {
+        if (!IsRecordShotHit(record, shot))
+        {
+            continue;
+        }
+
+        int shooter = shot & 1;                                         // Player1 fires the even shots
+        int cell = GetRecordShotCell(record, shot);
+        int ship = shipAt[1 - shooter][cell];
+
+        if (!hasHit[shooter])
+        {
+            total.firstHits[cell]++;
+            hasHit[shooter] = true;
+        }
+
+        if (ship >= 0 && ++shipHits[shooter][ship] == ClassicFleet::ShipSize(ship))
+        {
+            total.sinkOrder[ship][sunkCount[shooter]++]++;
+        }
+    }
+}
+
+static void ScanGameLogBlocks(int threadIndex, int begin, int end, void* context)
+{
+    const GameLogScan& scan = *(const GameLogScan*)context;
+    GameLogAccumulator& total = accumulators[threadIndex];
+    GameLogReader reader;
+    GameRecordView record;
+
+    InitializeGameLogReader(reader, scan.logData, begin, end);
+
+    while (NextGameRecord(reader, record))
+    {
+        if (IsValidGameRecord(record))                                  // The cells below index fixed-size arrays
+        {
+            AccumulateRecord(total, record);
+        }
+        else
+        {
+            total.damagedGames++;
+        }
+    }
+}
+
+bool AnalyzeGameLog(const char* path, GameLogSummary& summary)
+{
+    MappedFile file;
+
+    memset(&summary, 0, sizeof(summary));
+
+    if (!MapFile(path, file))
+    {
+        return false;
+    }
+
+    int numBlocks = GetGameLogBlockCount(file.data, file.size);
+
+    if (numBlocks < 0)
+    {
+        UnmapFile(file);
+        return false;
+    }
+
+    int numThreads = GetThreadPoolSize();
+    GameLogScan scan = { file.data };
+
+    memset(accumulators, 0, sizeof(GameLogAccumulator) * numThreads);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    ParallelFor(numBlocks, ANALYTICS_GRAIN_SIZE, ScanGameLogBlocks, &scan);
+
+    summary.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    summary.bytes = (long long)file.size;
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        const GameLogAccumulator& total = accumulators[t];
+
+        summary.games += total.games;
+        summary.damagedGames += total.damagedGames;
+
+        for (int s = 0; s < NUM_AI_STRATEGIES; s++)
+        {
+            summary.strategyGames[s] += total.strategyGames[s];
+            summary.strategyWins[s] += total.strategyWins[s];
+        }
+        for (int shots = 0; shots <= MAX_GAME_TURNS; shots++)
+        {
+            summary.shotHistogram[shots] += total.shotHistogram[shots];
+        }
+        for (int cell = 0; cell < BOARD_SIZE * BOARD_SIZE; cell++)
+        {
+            summary.firstHits[cell] += total.firstHits[cell];
+        }
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            for (int k = 0; k < NUM_SHIPS; k++)
+            {
+                summary.sinkOrder[ship][k] += total.sinkOrder[ship][k];
+            }
+        }
+    }
+
+    UnmapFile(file);
+    return true;
+}
+
+void PrintGameLogSummary(const GameLogSummary& summary)
+{
+    if (summary.games == 0)
+    {
+        cout << "No games in the log." << endl;
+        return;
+    }
+
+    cout << "Games:          " << summary.games << endl;
+
+    if (summary.damagedGames > 0)
+    {
+        cout << "Skipped:        " << summary.damagedGames << " damaged record(s)" << endl;
+    }
+    cout << "Scanned:        " << summary.bytes / 1048576.0 << " MB in " << summary.elapsedSeconds << " s";
+
+    if (summary.elapsedSeconds > 0)
+    {
+        cout << " (" << summary.bytes / 1048576.0 / summary.elapsedSeconds << " MB/s, " << summary.games / summary.elapsedSeconds << " games/sec)";
+    }
+
+    cout << endl << endl << "Strategy\tGames\tWin rate" << endl;
+
+    for (int s = 0; s < NUM_AI_STRATEGIES; s++)
+    {
+        if (summary.strategyGames[s] > 0)
+        {
+            cout << "  " << GetAIStrategyName(AIStrategyType(s)) << "\t" << summary.strategyGames[s] << "\t" << 100.0 * summary.strategyWins[s] / summary.strategyGames[s] << "%" << endl;
+        }
+    }
+
+    cout << endl << "Shots per game" << endl;
+
+    const int BUCKET_WIDTH = 10;
+
+    for (int first = 0; first <= MAX_GAME_TURNS; first += BUCKET_WIDTH)
+    {
+        long long count = 0;
+
+        for (int shots = first; shots < first + BUCKET_WIDTH && shots <= MAX_GAME_TURNS; shots++)
+        {
+            count += summary.shotHistogram[shots];
+        }
+
+        if (count > 0)
+        {
+            cout << "  " << first << "-" << first + BUCKET_WIDTH - 1 << "\t" << count << " (" << 100.0 * count / summary.games << "%)" << endl;
+        }
+    }
+
+    cout << endl << "Sink order (% of that ship's sinks at each position)" << endl;
+    cout << "  " << left << setw(18) << "Ship" << "1st\t2nd\t3rd\t4th\t5th" << endl << fixed << setprecision(1);
+
+    for (int ship = 0; ship < NUM_SHIPS; ship++)
+    {
+        long long sinks = 0;
+
+        for (int k = 0; k < NUM_SHIPS; k++)
+        {
+            sinks += summary.sinkOrder[ship][k];
+        }
+
+        cout << "  " << setw(18) << GetShipNameForShipType(ShipType(ship + 1));
+
+        for (int k = 0; k < NUM_SHIPS; k++)
+        {
+            cout << (sinks > 0 ? 100.0 * summary.sinkOrder[ship][k] / sinks : 0.0) << "\t";
+        }
+
+        cout << endl;
+    }
+
+    cout.copyfmt(ios(nullptr));                                         // Back to the default number formatting
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifndef __GAMEANALYTICS_H__
+#define __GAMEANALYTICS_H__
+
+#include "Game.h"
+#include "Simulation.h"
+
+/*
+    Queries over a binary game log. The log is mapped read-only and its blocks are scanned on the
+    thread pool, each thread adding into its own accumulator, and the accumulators are summed at
+    the end. Nothing is parsed through streams or copied out of the mapping.
+*/
+
+struct GameLogSummary
+{
+    long long games;
+    long long damagedGames;                                             // Records IsValidGameRecord turned down, not counted anywhere else
+    long long bytes;                                                    // Size of the log
+    double elapsedSeconds;
+
+    long long strategyGames[NUM_AI_STRATEGIES];                         // Games each strategy played, in either seat
+    long long strategyWins[NUM_AI_STRATEGIES];
+    long long shotHistogram[MAX_GAME_TURNS + 1];                        // Games by shots fired, both players together
+    long long firstHits[BOARD_SIZE * BOARD_SIZE];                       // Each player's first hit of a game, by cell
+    long long sinkOrder[NUM_SHIPS][NUM_SHIPS];                          // [ShipType - 1][k]: times that ship was the k-th one sunk
+};
+
+bool AnalyzeGameLog(const char* path, GameLogSummary& summary);          // False if the file can't be mapped or isn't a game log
+void PrintGameLogSummary(const GameLogSummary& summary);                // Everything but the heatmaps, which are drawn like the boards
+
+#endif
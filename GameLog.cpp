@@ -0,0 +1,386 @@
+// GameLog.cpp : Block-structured binary log of headless games.
+//
+
+#include <cstring>
+#include "GameLog.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const unsigned char FILE_MAGIC[4] = { 'B', 'S', 'G', 'L' };
+static const unsigned char BLOCK_MAGIC[4] = { 'G', 'B', 'L', 'K' };
+
+static void PutUInt32(unsigned char* out, unsigned int value)
+{
+    out[0] = (unsigned char)value;
+    out[1] = (unsigned char)(value >> 8);
+    out[2] = (unsigned char)(value >> 16);
+    out[3] = (unsigned char)(value >> 24);
+}
+
+static unsigned int GetUInt32(const unsigned char* in)
+{
+    return unsigned(in[0]) | unsigned(in[1]) << 8 | unsigned(in[2]) << 16 | unsigned(in[3]) << 24;
+}
+
+/* Writing */
+
+void RecordFleet(GameRecord& record, int player, const Player& fleetOwner)
+{
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        const Ship& ship = fleetOwner.ships[i];
+        int cell = CellIndex(ship.shipPosition.row, ship.shipPosition.col);
+
+        record.fleets[player][i] = (unsigned char)(cell | (ship.shipOrientation == SO_VERTICAL ? 0x80 : 0));
+    }
+}
+
+void RecordShot(GameRecord& record, ShipPositionType guess, bool isHit)
+{
+    record.shots[record.numShots++] = (unsigned char)(CellIndex(guess.row, guess.col) | (isHit ? 0x80 : 0));
+}
+
+bool CreateGameLog(GameLogFile& log, const char* path)
+{
+    unsigned char header[GAME_LOG_FILE_HEADER_SIZE];
+
+#ifdef _WIN32
+    if (fopen_s(&log.file, path, "wb") != 0)
+    {
+        log.file = nullptr;
+    }
+#else
+    log.file = fopen(path, "wb");
+#endif
+    log.blocksWritten = 0;
+    log.hasFailed = false;
+
+    if (log.file == nullptr)
+    {
+        return false;
+    }
+
+    memcpy(header, FILE_MAGIC, 4);
+    PutUInt32(header + 4, GAME_LOG_VERSION);
+
+    if (fwrite(header, 1, sizeof(header), log.file) != sizeof(header))
+    {
+        fclose(log.file);
+        log.file = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool CloseGameLog(GameLogFile& log)
+{
+    bool isClean = !log.hasFailed;
+
+    if (log.file != nullptr)
+    {
+        isClean = fclose(log.file) == 0 && isClean;                     // fclose writes whatever stdio still buffers
+        log.file = nullptr;
+    }
+    return isClean;
+}
+
+static void StartBlock(GameLogWriter& writer)
+{
+    writer.blockBytes = GAME_LOG_BLOCK_HEADER_SIZE;
+    writer.blockRecords = 0;
+}
+
+void InitializeGameLogWriter(GameLogWriter& writer, GameLogFile& log)
+{
+    writer.log = &log;
+    writer.hasFailed = false;
+    StartBlock(writer);
+}
+
+bool FlushGameLogWriter(GameLogWriter& writer)
+{
+    if (writer.blockRecords == 0)
+    {
+        return !writer.hasFailed;
+    }
+
+    memcpy(writer.block, BLOCK_MAGIC, 4);
+    PutUInt32(writer.block + 4, unsigned(writer.blockBytes - GAME_LOG_BLOCK_HEADER_SIZE));
+    PutUInt32(writer.block + 8, unsigned(writer.blockRecords));
+    memset(writer.block + writer.blockBytes, 0, GAME_LOG_BLOCK_SIZE - writer.blockBytes);
+
+    {
+        std::lock_guard<std::mutex> lock(writer.log->mutex);
+        GameLogFile& log = *writer.log;
+
+        if (!log.hasFailed && fwrite(writer.block, 1, GAME_LOG_BLOCK_SIZE, log.file) == GAME_LOG_BLOCK_SIZE)
+        {
+            log.blocksWritten++;
+        }
+        else
+        {
+            log.hasFailed = true;                                       // A short write leaves a torn block, later blocks would be misaligned
+            writer.hasFailed = true;
+        }
+    }
+
+    StartBlock(writer);
+    return !writer.hasFailed;
+}
+
+bool AppendGameRecord(GameLogWriter& writer, const GameRecord& record)
+{
+    int size = GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE + record.numShots;
+
+    if (writer.hasFailed)
+    {
+        return false;
+    }
+    if (writer.blockBytes + size > GAME_LOG_BLOCK_SIZE && !FlushGameLogWriter(writer))
+    {
+        return false;
+    }
+
+    unsigned char* out = writer.block + writer.blockBytes;
+
+    PutUInt32(out, record.seed);
+    out[4] = (unsigned char)(record.strategies[0] | (record.strategies[1] << 4));
+    out[5] = record.winner;
+    out[6] = record.numShots;
+    memcpy(out + GAME_RECORD_HEADER_SIZE, record.fleets, GAME_RECORD_FLEET_SIZE);
+    memcpy(out + GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE, record.shots, record.numShots);
+
+    writer.blockBytes += size;
+    writer.blockRecords++;
+    return true;
+}
+
+/* Reading */
+
+bool MapFile(const char* path, MappedFile& file)
+{
+    file.data = nullptr;
+    file.size = 0;
+
+#ifdef _WIN32
+    file.fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    file.mappingHandle = NULL;
+
+    if (file.fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file.fileHandle, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file.fileHandle);
+        return false;
+    }
+
+    file.mappingHandle = CreateFileMappingA(file.fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (file.mappingHandle == NULL)
+    {
+        CloseHandle(file.fileHandle);
+        return false;
+    }
+
+    file.data = (const unsigned char*)MapViewOfFile(file.mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    file.size = size_t(size.QuadPart);
+#else
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);                                                          // The mapping keeps the file open
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    madvise(data, size_t(info.st_size), MADV_SEQUENTIAL);
+
+    file.data = (const unsigned char*)data;
+    file.size = size_t(info.st_size);
+#endif
+
+    return file.data != nullptr;
+}
+
+void UnmapFile(MappedFile& file)
+{
+#ifdef _WIN32
+    if (file.data != nullptr)
+    {
+        UnmapViewOfFile(file.data);
+    }
+    if (file.mappingHandle != NULL)
+    {
+        CloseHandle(file.mappingHandle);
+    }
+    if (file.fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file.fileHandle);
+    }
+#else
+    if (file.data != nullptr)
+    {
+        munmap((void*)file.data, file.size);
+    }
+#endif
+
+    file.data = nullptr;
+    file.size = 0;
+}
+
+int GetGameLogBlockCount(const void* logData, size_t logSize)
+{
+    const unsigned char* data = (const unsigned char*)logData;
+
+    if (logSize < GAME_LOG_FILE_HEADER_SIZE || memcmp(data, FILE_MAGIC, 4) != 0 || GetUInt32(data + 4) != GAME_LOG_VERSION)
+    {
+        return -1;
+    }
+
+    return int((logSize - GAME_LOG_FILE_HEADER_SIZE) / GAME_LOG_BLOCK_SIZE);   // A torn last block is left out
+}
+
+void InitializeGameLogReader(GameLogReader& reader, const void* logData, int firstBlock, int endBlock)
+{
+    const unsigned char* blocks = (const unsigned char*)logData + GAME_LOG_FILE_HEADER_SIZE;
+
+    reader.nextBlock = blocks + size_t(firstBlock) * GAME_LOG_BLOCK_SIZE;
+    reader.blocksEnd = blocks + size_t(endBlock) * GAME_LOG_BLOCK_SIZE;
+    reader.nextRecord = nullptr;
+    reader.recordsEnd = nullptr;
+    reader.recordsLeft = 0;
+}
+
+/*
+    Neither the record count in a block header nor a record's shot count is trusted. A record is
+    only handed out if it fits in what is left of the block's payload and its shot count is one a
+    game can have; the first one that does not ends the block, since the records after it cannot
+    be found.
+*/
+bool NextGameRecord(GameLogReader& reader, GameRecordView& record)
+{
+    for (;;)
+    {
+        if (reader.recordsLeft > 0)
+        {
+            size_t bytesLeft = size_t(reader.recordsEnd - reader.nextRecord);
+            GameRecordView next = { reader.nextRecord };
+
+            if (bytesLeft >= GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE && GetRecordShotCount(next) <= MAX_GAME_TURNS)
+            {
+                size_t size = GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE + GetRecordShotCount(next);
+
+                if (size <= bytesLeft)
+                {
+                    record = next;
+                    reader.nextRecord += size;
+                    reader.recordsLeft--;
+                    return true;
+                }
+            }
+
+            reader.recordsLeft = 0;                                     // Damaged record, drop the rest of the block
+        }
+
+        if (reader.nextBlock >= reader.blocksEnd)
+        {
+            return false;
+        }
+
+        const unsigned char* block = reader.nextBlock;
+        unsigned int payloadSize = GetUInt32(block + 4);
+
+        reader.nextBlock += GAME_LOG_BLOCK_SIZE;
+
+        if (memcmp(block, BLOCK_MAGIC, 4) != 0 || payloadSize > GAME_LOG_BLOCK_SIZE - GAME_LOG_BLOCK_HEADER_SIZE)
+        {
+            continue;                                                   // Damaged block, skip to the next one
+        }
+
+        unsigned int numRecords = GetUInt32(block + 8);
+
+        reader.nextRecord = block + GAME_LOG_BLOCK_HEADER_SIZE;
+        reader.recordsEnd = reader.nextRecord + payloadSize;
+        reader.recordsLeft = numRecords < payloadSize ? int(numRecords) : int(payloadSize);   // Every record takes at least one byte
+    }
+}
+
+bool IsValidGameRecord(GameRecordView record)
+{
+    int numShots = GetRecordShotCount(record);
+
+    if (GetRecordWinner(record) > 1 || numShots > MAX_GAME_TURNS)
+    {
+        return false;
+    }
+
+    for (int player = 0; player < 2; player++)
+    {
+        BoardMask occupied = EmptyMask();
+
+        for (int ship = 0; ship < NUM_SHIPS; ship++)
+        {
+            int cell = GetRecordShipCell(record, player, ship);
+            bool vertical = GetRecordShipOrientation(record, player, ship) == SO_VERTICAL;
+            int row = cell / BOARD_SIZE;
+            int col = cell % BOARD_SIZE;
+
+            if (cell >= BOARD_SIZE * BOARD_SIZE || (vertical ? row : col) + ClassicFleet::ShipSize(ship) > BOARD_SIZE)
+            {
+                return false;
+            }
+
+            BoardMask shipMask = LineMask(row, col, ClassicFleet::ShipSize(ship), vertical);
+
+            if (MaskIntersects(occupied, shipMask))
+            {
+                return false;
+            }
+            occupied = MaskOr(occupied, shipMask);
+        }
+    }
+
+    BoardMask fired[2] = { EmptyMask(), EmptyMask() };
+
+    for (int shot = 0; shot < numShots; shot++)
+    {
+        int cell = GetRecordShotCell(record, shot);
+
+        if (cell >= BOARD_SIZE * BOARD_SIZE || TestCell(fired[shot & 1], cell))   // Nobody fires at a cell twice
+        {
+            return false;
+        }
+        SetCell(fired[shot & 1], cell);
+    }
+    return true;
+}
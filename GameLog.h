@@ -0,0 +1,157 @@
+#pragma once
+
+#ifndef __GAMELOG_H__
+#define __GAMELOG_H__
+
+#include <cstdio>
+#include <cstddef>
+#include <mutex>
+#include "Game.h"
+#include "Simulation.h"
+
+/*
+    Binary log of headless games. A log is an 8 byte file header followed by fixed-size blocks, so
+    a reader can split a file into block ranges and scan them on separate threads. Each block has a
+    12 byte header and a run of records, and is zero padded to the block size.
+
+    Record layout, all integers little endian:
+
+        seed            4 bytes
+        strategies      1 byte      Player1's AIStrategyType in the low nibble, Player2's in the high nibble
+        winner          1 byte      0 for Player1, 1 for Player2
+        shot count      1 byte
+        fleets          10 bytes    Per player, per ship in ships[] order: cell (row * 10 + col) | vertical << 7
+        shots           1 byte each Cell | hit << 7, the players take turns starting with Player1
+
+    The ship type is given by the position in ships[], so a game takes 17 bytes plus one per shot.
+*/
+
+enum
+{
+    GAME_LOG_VERSION = 1,
+    GAME_LOG_FILE_HEADER_SIZE = 8,
+    GAME_LOG_BLOCK_SIZE = 16384,
+    GAME_LOG_BLOCK_HEADER_SIZE = 12,
+    GAME_RECORD_HEADER_SIZE = 7,
+    GAME_RECORD_FLEET_SIZE = 2 * NUM_SHIPS,
+    MAX_GAME_RECORD_SIZE = GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE + MAX_GAME_TURNS
+};
+
+static_assert(MAX_GAME_TURNS <= 255, "The shot count is stored in one byte");
+static_assert(BOARD_SIZE * BOARD_SIZE <= 128, "Cells are stored in seven bits");
+
+struct GameRecord                                                       // One game as it is about to be written, no pointers or allocation
+{
+    unsigned int seed;
+    unsigned char strategies[2];
+    unsigned char winner;
+    unsigned char numShots;
+    unsigned char fleets[2][NUM_SHIPS];                                 // Cell | vertical << 7
+    unsigned char shots[MAX_GAME_TURNS];                                // Cell | hit << 7
+};
+
+struct GameLogFile                                                      // Shared by the writers of one log, whole blocks go out under the mutex
+{
+    FILE* file;
+    std::mutex mutex;
+    long long blocksWritten;
+    bool hasFailed;                                                     // A block did not go out whole, nothing is written after it
+};
+
+struct GameLogWriter                                                    // One per thread, fills a block in place and hands it to the file when full
+{
+    GameLogFile* log;
+    unsigned char block[GAME_LOG_BLOCK_SIZE];
+    int blockBytes;
+    int blockRecords;
+    bool hasFailed;                                                     // Set once the log has failed, records are dropped from then on
+};
+
+struct GameRecordView                                                   // Points straight into the log data, valid as long as that is
+{
+    const unsigned char* data;
+};
+
+struct GameLogReader
+{
+    const unsigned char* nextBlock;
+    const unsigned char* blocksEnd;
+    const unsigned char* nextRecord;
+    const unsigned char* recordsEnd;                                    // End of the current block's payload
+    int recordsLeft;                                                    // In the current block, as its header claims
+};
+
+struct MappedFile
+{
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+/* Writing */
+
+void RecordFleet(GameRecord& record, int player, const Player& fleetOwner);
+void RecordShot(GameRecord& record, ShipPositionType guess, bool isHit);
+
+bool CreateGameLog(GameLogFile& log, const char* path);                 // False if the file could not be opened or its header written
+bool CloseGameLog(GameLogFile& log);                                    // False if a write failed or the file did not close cleanly
+void InitializeGameLogWriter(GameLogWriter& writer, GameLogFile& log);
+bool AppendGameRecord(GameLogWriter& writer, const GameRecord& record); // False once the log has failed, the record is not kept
+bool FlushGameLogWriter(GameLogWriter& writer);                         // Writes the partly filled block, call before closing the log
+
+/* Reading */
+
+bool MapFile(const char* path, MappedFile& file);                       // Read-only mapping of the whole file
+void UnmapFile(MappedFile& file);
+
+int GetGameLogBlockCount(const void* logData, size_t logSize);          // -1 if the data is not a game log
+void InitializeGameLogReader(GameLogReader& reader, const void* logData, int firstBlock, int endBlock);
+bool NextGameRecord(GameLogReader& reader, GameRecordView& record);
+bool IsValidGameRecord(GameRecordView record);                          // Winner, fleets and shots all possible, check before indexing by them
+
+/* Record fields, read in place */
+
+inline unsigned int GetRecordSeed(GameRecordView record)
+{
+    return unsigned(record.data[0]) | unsigned(record.data[1]) << 8 | unsigned(record.data[2]) << 16 | unsigned(record.data[3]) << 24;
+}
+
+inline AIStrategyType GetRecordStrategy(GameRecordView record, int player)
+{
+    return AIStrategyType((record.data[4] >> (4 * player)) & 0xF);
+}
+
+inline int GetRecordWinner(GameRecordView record)
+{
+    return record.data[5];
+}
+
+inline int GetRecordShotCount(GameRecordView record)
+{
+    return record.data[6];
+}
+
+inline int GetRecordShipCell(GameRecordView record, int player, int ship)
+{
+    return record.data[GAME_RECORD_HEADER_SIZE + player * NUM_SHIPS + ship] & 0x7F;
+}
+
+inline ShipOrientationType GetRecordShipOrientation(GameRecordView record, int player, int ship)
+{
+    return (record.data[GAME_RECORD_HEADER_SIZE + player * NUM_SHIPS + ship] & 0x80) ? SO_VERTICAL : SO_HORIZONTAL;
+}
+
+inline int GetRecordShotCell(GameRecordView record, int shot)
+{
+    return record.data[GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE + shot] & 0x7F;
+}
+
+inline bool IsRecordShotHit(GameRecordView record, int shot)
+{
+    return (record.data[GAME_RECORD_HEADER_SIZE + GAME_RECORD_FLEET_SIZE + shot] & 0x80) != 0;
+}
+
+#endif
@@ -0,0 +1,221 @@
+// Input.cpp : Buffered line reads from a file descriptor and one-pass move parsing.
+//
+
+#include <cstring>
+#include <chrono>
+#include "Input.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#else
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+using namespace std;
+
+static bool WaitForInput(int fd, int timeoutMilliseconds)               // False if nothing arrived in time, a negative timeout waits forever
+{
+#ifdef _WIN32
+    (void)fd;
+    (void)timeoutMilliseconds;
+    return true;                                                        // No timeouts on Windows, the read just blocks
+#else
+    if (timeoutMilliseconds < 0)
+    {
+        return true;
+    }
+
+    pollfd request;
+
+    request.fd = fd;
+    request.events = POLLIN;
+    request.revents = 0;
+
+    return poll(&request, 1, timeoutMilliseconds) > 0;                  // Readable, closed or failed all count, the read tells them apart
+#endif
+}
+
+static bool FillInputBuffer(InputReader& reader)
+{
+    if (reader.start > 0)                                               // Keep the partial line, move it to the front
+    {
+        memmove(reader.data, reader.data + reader.start, reader.end - reader.start);
+        reader.end -= reader.start;
+        reader.start = 0;
+    }
+
+    if (reader.isEndOfInput || reader.end == INPUT_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    int count = int(read(reader.fd, reader.data + reader.end, unsigned(INPUT_BUFFER_SIZE - reader.end)));
+
+    if (count <= 0)                                                     // End of input, or an error that would only repeat
+    {
+        reader.isEndOfInput = true;
+        return false;
+    }
+
+    reader.end += count;
+    return true;
+}
+
+void InitializeInputReader(InputReader& reader, int fd)
+{
+    reader.fd = fd;
+    reader.start = 0;
+    reader.end = 0;
+    reader.isEndOfInput = false;
+}
+
+bool ReadInputLine(InputReader& reader, char line[], int lineSize)
+{
+    return ReadInputLineWithin(reader, line, lineSize, -1) == IR_LINE;
+}
+
+InputReadType ReadInputLineWithin(InputReader& reader, char line[], int lineSize, int timeoutMilliseconds)
+{
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMilliseconds);
+
+    for (;;)
+    {
+        const char* begin = reader.data + reader.start;
+        const char* newline = (const char*)memchr(begin, '\n', reader.end - reader.start);
+
+        if (newline == nullptr && !reader.isEndOfInput && timeoutMilliseconds >= 0)
+        {
+            long long remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+
+            if (remaining < 0 || !WaitForInput(reader.fd, int(remaining)))
+            {
+                return IR_TIMEOUT;
+            }
+        }
+
+        if (newline != nullptr || !FillInputBuffer(reader))
+        {
+            begin = reader.data + reader.start;                         // The fill may have moved the data
+            newline = (const char*)memchr(begin, '\n', reader.end - reader.start);
+
+            int length = newline != nullptr ? int(newline - begin) : reader.end - reader.start;
+
+            if (newline == nullptr && length == 0)
+            {
+                return IR_END;                                          // Nothing left, not even a last line without '\n'
+            }
+
+            reader.start += newline != nullptr ? length + 1 : length;
+
+            if (length > 0 && begin[length - 1] == '\r')
+            {
+                length--;
+            }
+            if (length > lineSize - 1)
+            {
+                length = lineSize - 1;
+            }
+
+            memcpy(line, begin, length);
+            line[length] = '\0';
+            return IR_LINE;
+        }
+    }
+}
+
+InputReader& GetStandardInput()
+{
+    static InputReader reader;
+    static bool isInitialized = false;
+
+    if (!isInitialized)
+    {
+        InitializeInputReader(reader, 0);
+        isInitialized = true;
+    }
+    return reader;
+}
+
+static const char* SkipSeparators(const char* text)
+{
+    while (*text == ' ' || *text == '\t' || *text == ',')
+    {
+        text++;
+    }
+    return text;
+}
+
+static char ToUpper(char c)                                             // ASCII only, no locale
+{
+    return c >= 'a' && c <= 'z' ? char(c - 'a' + 'A') : c;
+}
+
+MoveParseType ParseMove(const char* text, int numRows, int numCols, MoveInput& move)
+{
+    text = SkipSeparators(text);
+
+    char rowLetter = ToUpper(*text);
+
+    if (rowLetter < 'A' || rowLetter >= 'A' + numRows)
+    {
+        return MP_INVALID;
+    }
+
+    move.row = rowLetter - 'A';
+    move.col = -1;
+    move.orientation = 0;
+
+    text = SkipSeparators(text + 1);
+
+    if (*text == '\0')
+    {
+        return MP_ROW_ONLY;
+    }
+
+    int col = 0;
+    int digits = 0;
+
+    while (*text >= '0' && *text <= '9' && digits < 4)
+    {
+        col = col * 10 + (*text++ - '0');
+        digits++;
+    }
+
+    if (digits == 0 || col < 1 || col > numCols)
+    {
+        return MP_INVALID;
+    }
+
+    move.col = col - 1;
+    text = SkipSeparators(text);
+
+    if (*text == '\0')
+    {
+        return MP_CELL;
+    }
+
+    char orientation = ToUpper(*text);
+
+    if (orientation != 'H' && orientation != 'V')
+    {
+        return MP_INVALID;
+    }
+
+    const char* word = orientation == 'H' ? "HORIZONTAL" : "VERTICAL";  // Accept "H", "h", "Horizontal"... but nothing else after it
+
+    while (*text != '\0' && *word != '\0' && ToUpper(*text) == *word)
+    {
+        text++;
+        word++;
+    }
+
+    if (*SkipSeparators(text) != '\0')
+    {
+        return MP_INVALID;
+    }
+
+    move.orientation = orientation;
+    return MP_CELL_AND_ORIENTATION;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef __INPUT_H__
+#define __INPUT_H__
+
+/*
+    Line input straight from a file descriptor. ReadInputLine fills a 64 KB buffer with read() and
+    hands out one line at a time, so a bot piping in thousands of moves costs one system call per
+    buffer rather than a stream round trip per field, and nothing goes through iostream or its
+    locale. ParseMove then reads a whole move from the line in one pass:
+
+        "B7"  "b 7"  "B10"  "B,7"       a cell
+        "B7 H"  "b7v"  "B 7 horizontal" a cell and a ship orientation
+        "B"                             a row only, the caller asks for the column
+
+    Rows are letters from 'A' and columns numbers from 1, either case, spaces and commas ignored.
+*/
+
+enum
+{
+    INPUT_BUFFER_SIZE = 65536,
+    MAX_INPUT_LINE = 256                                                // Longer lines are cut, the rest is dropped
+};
+
+enum MoveParseType
+{
+    MP_INVALID = 0,
+    MP_ROW_ONLY,
+    MP_CELL,
+    MP_CELL_AND_ORIENTATION
+};
+
+enum InputReadType
+{
+    IR_LINE = 0,
+    IR_END,                                                             // The input is used up
+    IR_TIMEOUT                                                          // No whole line in time, what did arrive stays buffered
+};
+
+struct InputReader
+{
+    int fd;
+    int start;                                                          // Next unread byte of data
+    int end;
+    bool isEndOfInput;
+    char data[INPUT_BUFFER_SIZE];
+};
+
+struct MoveInput
+{
+    int row;                                                            // From 0
+    int col;                                                            // From 0
+    char orientation;                                                   // 'H' or 'V', 0 if not given
+};
+
+void InitializeInputReader(InputReader& reader, int fd);
+bool ReadInputLine(InputReader& reader, char line[], int lineSize);     // False once the input is used up, the line has no '\n'
+InputReadType ReadInputLineWithin(InputReader& reader, char line[], int lineSize, int timeoutMilliseconds);   // Negative waits forever, Windows always does
+InputReader& GetStandardInput();                                        // Reader over fd 0 shared by all the prompts
+
+MoveParseType ParseMove(const char* text, int numRows, int numCols, MoveInput& move);
+
+#endif
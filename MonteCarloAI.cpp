@@ -0,0 +1,313 @@
+// MonteCarloAI.cpp : AI that fires where sampled fleets consistent with the board overlap most.
+//
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include "MonteCarloAI.h"
+#include "FleetSampler.h"
+#include "ThreadPool.h"
+#include "Random.h"
+
+using namespace std;
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE,
+    SAMPLE_BLOCK_SIZE = 64,                                             // Samples between checks of the clock
+    FIXED_SAMPLE_CHUNKS = 16                                            // With a sample count, the same split on any number of threads
+};
+
+struct alignas(64) MonteCarloChunk                                      // One pool task's share of a move, written by that task only
+{
+    int counts[NUM_CELLS];                                              // Samples occupying each cell, among those with bestCoverage
+    int bestCoverage;                                                   // Most unresolved hits any sample covered so far
+    long long samples;
+    long long acceptedSamples;
+};
+
+struct MonteCarloContext
+{
+    BoardMask blockedMask;                                              // Misses and sunk ships, no afloat ship can be there
+    BoardMask openHits;                                                 // Hits on ships still afloat
+    BoardMask guessedMask;
+    int numOpenHits;
+    int shipSizes[NUM_SHIPS];                                           // Afloat ships, largest first
+    int numShips;
+    uint64_t seed;
+    chrono::steady_clock::time_point deadline;                          // Only used without a sample count
+    int numSamples;                                                     // Over all chunks, 0 to sample until the deadline
+    int numChunks;
+    MonteCarloChunk* chunks;
+};
+
+static double budgetMilliseconds = 1.0;
+static int budgetSamples = 0;
+
+static atomic<long long> totalMoves(0);
+static atomic<long long> totalSamples(0);
+static atomic<long long> totalAccepted(0);
+static atomic<long long> totalNanoseconds(0);
+
+/*
+    One fleet of the afloat ships, drawn around the blocked cells. Returns the cells it occupies, or
+    an empty mask if the ships could not all be placed.
+*/
+static BoardMask SampleFleet(RandomState& random, const MonteCarloContext& context)
+{
+    BoardMask occupied = context.blockedMask;
+    BoardMask fleet = EmptyMask();
+
+    for (int i = 0; i < context.numShips; i++)
+    {
+        ShipPlacement placement;
+
+        if (!SampleShipPlacement(random, occupied, context.shipSizes[i], placement))
+        {
+            return EmptyMask();
+        }
+
+        occupied = MaskOr(occupied, placement.mask);
+        fleet = MaskOr(fleet, placement.mask);
+    }
+    return fleet;
+}
+
+static void SampleFleets(int, int begin, int end, void* context)
+{
+    const MonteCarloContext& move = *(const MonteCarloContext*)context;
+
+    for (int index = begin; index < end; index++)
+    {
+        MonteCarloChunk& chunk = move.chunks[index];
+        long long chunkSamples = (long long)move.numSamples * (index + 1) / move.numChunks - (long long)move.numSamples * index / move.numChunks;
+        RandomState random;
+
+        SeedRandom(random, move.seed + index);
+
+        do                                                              // At least one block, so every chunk contributes something
+        {
+            long long blockSize = move.numSamples > 0 && chunkSamples - chunk.samples < SAMPLE_BLOCK_SIZE ? chunkSamples - chunk.samples : SAMPLE_BLOCK_SIZE;
+
+            for (long long s = 0; s < blockSize; s++)
+            {
+                BoardMask fleet = SampleFleet(random, move);
+
+                chunk.samples++;
+
+                if (MaskIsEmpty(fleet))
+                {
+                    continue;
+                }
+
+                int coverage = MaskPopCount(MaskAnd(fleet, move.openHits));
+
+                if (coverage < chunk.bestCoverage)
+                {
+                    continue;
+                }
+                if (coverage > chunk.bestCoverage)                      // Closer to the board than anything so far, start counting again
+                {
+                    memset(chunk.counts, 0, sizeof(chunk.counts));
+                    chunk.bestCoverage = coverage;
+                    chunk.acceptedSamples = 0;
+                }
+
+                chunk.acceptedSamples++;
+
+                BoardMask cells = MaskAndNot(fleet, move.guessedMask);
+
+                for (int cell = MaskFirstCell(cells); cell >= 0; cell = MaskFirstCell(cells))
+                {
+                    ClearCell(cells, cell);
+                    chunk.counts[cell]++;
+                }
+            }
+
+        } while (move.numSamples > 0 ? chunk.samples < chunkSamples : chrono::steady_clock::now() < move.deadline);
+    }
+}
+
+/*
+    The calling thread's chunks, allocated on its first move and grown if a later move needs more.
+    Threads that never sample pay one pointer of thread-local storage.
+*/
+static MonteCarloChunk* GetThreadChunks(int numChunks)
+{
+    static thread_local unique_ptr<unsigned char[]> memory;
+    static thread_local int capacity = 0;
+
+    if (numChunks > capacity)
+    {
+        memory.reset(new unsigned char[sizeof(MonteCarloChunk) * numChunks + alignof(MonteCarloChunk)]);
+        capacity = numChunks;
+    }
+
+    uintptr_t address = uintptr_t(memory.get());
+
+    return (MonteCarloChunk*)(address + (alignof(MonteCarloChunk) - address % alignof(MonteCarloChunk)) % alignof(MonteCarloChunk));
+}
+
+ShipPositionType GetMonteCarloGuess(const Player& aiPlayer)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    RandomState& random = GetThreadRandom();
+    MonteCarloContext context;
+
+    context.blockedMask = MaskOr(aiPlayer.guessMissMask, aiPlayer.guessSunkMask);
+    context.openHits = MaskAndNot(aiPlayer.guessHitMask, aiPlayer.guessSunkMask);
+    context.guessedMask = MaskOr(aiPlayer.guessHitMask, aiPlayer.guessMissMask);
+    context.numOpenHits = MaskPopCount(context.openHits);
+    context.numShips = 0;
+
+    for (int i = 0; i < NUM_SHIPS; i++)                                 // Both fleets have the same make-up, ships[] is largest first
+    {
+        if (!(aiPlayer.sunkShipFlags & (1 << i)))
+        {
+            context.shipSizes[context.numShips++] = aiPlayer.ships[i].shipSize;
+        }
+    }
+
+    context.seed = NextRandom(random);
+    context.deadline = start + chrono::nanoseconds((long long)(budgetMilliseconds * 1e6));
+    context.numSamples = budgetSamples;
+    context.numChunks = budgetSamples > 0 ? FIXED_SAMPLE_CHUNKS : GetParallelWidth();
+
+    int numChunks = context.numChunks;
+    MonteCarloChunk* chunks = GetThreadChunks(numChunks);              // Per calling thread, games on the pool sample at the same time
+
+    memset(chunks, 0, sizeof(MonteCarloChunk) * numChunks);
+    context.chunks = chunks;
+
+    ParallelFor(numChunks, 1, SampleFleets, &context);
+
+    int bestCoverage = 0;
+    long long samples = 0;
+    long long accepted = 0;
+    int counts[NUM_CELLS] = {};
+
+    for (int i = 0; i < numChunks; i++)
+    {
+        if (chunks[i].bestCoverage > bestCoverage)
+        {
+            bestCoverage = chunks[i].bestCoverage;
+        }
+    }
+
+    for (int i = 0; i < numChunks; i++)                                 // Only merge chunks that reached the same coverage
+    {
+        samples += chunks[i].samples;
+
+        if (chunks[i].bestCoverage != bestCoverage)
+        {
+            continue;
+        }
+
+        accepted += bestCoverage == context.numOpenHits ? chunks[i].acceptedSamples : 0;
+
+        for (int cell = 0; cell < NUM_CELLS; cell++)
+        {
+            counts[cell] += chunks[i].counts[cell];
+        }
+    }
+
+    int bestCell = -1;
+    int bestCount = 0;
+    int ties = 0;
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)                        // Counts are zero on guessed cells, ties broken at random
+    {
+        if (counts[cell] > bestCount)
+        {
+            bestCount = counts[cell];
+            bestCell = cell;
+            ties = 1;
+        }
+        else if (counts[cell] == bestCount && bestCount > 0 && RandomInt(random, ++ties) == 0)
+        {
+            bestCell = cell;
+        }
+    }
+
+    totalMoves++;
+    totalSamples += samples;
+    totalAccepted += accepted;
+    totalNanoseconds += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    if (bestCell < 0)
+    {
+        return GetRandomPosition();                                     // No sample put a ship on an unguessed cell
+    }
+
+    ShipPositionType position;
+
+    position.row = bestCell / BOARD_SIZE;
+    position.col = bestCell % BOARD_SIZE;
+
+    return position;
+}
+
+void SetMonteCarloBudget(double milliseconds)
+{
+    budgetMilliseconds = milliseconds;
+}
+
+double GetMonteCarloBudget()
+{
+    return budgetMilliseconds;
+}
+
+void SetMonteCarloSamples(int samples)
+{
+    budgetSamples = samples;
+}
+
+int GetMonteCarloSamples()
+{
+    return budgetSamples;
+}
+
+void ResetMonteCarloStats()
+{
+    totalMoves = 0;
+    totalSamples = 0;
+    totalAccepted = 0;
+    totalNanoseconds = 0;
+}
+
+MonteCarloStats GetMonteCarloStats()
+{
+    MonteCarloStats stats;
+
+    stats.moves = totalMoves;
+    stats.samples = totalSamples;
+    stats.acceptedSamples = totalAccepted;
+    stats.seconds = totalNanoseconds * 1e-9;
+
+    return stats;
+}
+
+void PrintMonteCarloStats()
+{
+    MonteCarloStats stats = GetMonteCarloStats();
+
+    if (stats.moves == 0)
+    {
+        return;
+    }
+
+    if (budgetSamples > 0)
+    {
+        cout << endl << "Monte Carlo AI (" << budgetSamples << " samples per move)" << endl;
+    }
+    else
+    {
+        cout << endl << "Monte Carlo AI (" << budgetMilliseconds << " ms per move)" << endl;
+    }
+
+    cout << "Moves:          " << stats.moves << endl;
+    cout << "Samples/move:   avg " << double(stats.samples) / stats.moves << " (" << 100.0 * stats.acceptedSamples / (stats.samples > 0 ? stats.samples : 1) << "% consistent with the board)" << endl;
+    cout << "Samples/sec:    " << (stats.seconds > 0 ? stats.samples / stats.seconds : 0.0) << endl;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef __MONTECARLOAI_H__
+#define __MONTECARLOAI_H__
+
+#include "Game.h"
+
+/*
+    Posterior-sampling AI. Each move samples random layouts of the ships still afloat that avoid the
+    misses and the cells of sunk ships, keeps the ones that cover every unresolved hit, and fires at
+    the unguessed cell occupied in the most of them. Sampling runs on the thread pool until the
+    per-move time budget is spent. If no sample covers every hit, the samples covering the most hits
+    are used instead.
+
+    A time budget makes a move depend on how fast the machine is, so the same seed can give a
+    different game. With a sample count instead, every move draws exactly that many fleets in a
+    fixed number of chunks seeded from the game's generator, and a seed always replays the same way.
+*/
+
+enum
+{
+    DEFAULT_MONTE_CARLO_SAMPLES = 8192                                  // About 1 ms on one core, used for seeded and recorded runs
+};
+
+struct MonteCarloStats                                                  // Totals over every move since the last reset
+{
+    long long moves;
+    long long samples;                                                  // Fleets drawn
+    long long acceptedSamples;                                          // Fleets consistent with the board
+    double seconds;                                                     // Wall time spent sampling
+};
+
+void SetMonteCarloBudget(double milliseconds);                          // Sampling time per move, default 1 ms
+double GetMonteCarloBudget();
+void SetMonteCarloSamples(int samples);                                 // Fixed samples per move instead of the time budget, 0 to go back
+int GetMonteCarloSamples();
+ShipPositionType GetMonteCarloGuess(const Player& aiPlayer);
+
+void ResetMonteCarloStats();
+MonteCarloStats GetMonteCarloStats();
+void PrintMonteCarloStats();
+
+#endif
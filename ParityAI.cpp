@@ -0,0 +1,222 @@
+// ParityAI.cpp : Hunt/target AI that hunts on a checkerboard and keeps its candidates as bitsets.
+//
+
+#include "ParityAI.h"
+#include "Random.h"
+
+enum
+{
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE
+};
+
+struct ParityTables
+{
+    BoardMask boardMask;                                                // Every cell of the board
+    BoardMask notFirstColumn;                                           // Where a shift one cell east may land
+    BoardMask notLastColumn;                                            // Where a shift one cell west may land
+    BoardMask spacingMasks[MAX_SHIP_SIZE + 1];                          // Cells with (row + col) % spacing == 0
+    BoardMask neighbourMasks[NUM_CELLS];                                // The up to four cells next to each cell
+};
+
+static ParityTables BuildParityTables()
+{
+    ParityTables tables = {};
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        for (int c = 0; c < BOARD_SIZE; c++)
+        {
+            int cell = CellIndex(r, c);
+
+            SetCell(tables.boardMask, cell);
+
+            if (c > 0)
+            {
+                SetCell(tables.notFirstColumn, cell);
+                SetCell(tables.neighbourMasks[cell], cell - 1);
+            }
+            if (c < BOARD_SIZE - 1)
+            {
+                SetCell(tables.notLastColumn, cell);
+                SetCell(tables.neighbourMasks[cell], cell + 1);
+            }
+            if (r > 0)
+            {
+                SetCell(tables.neighbourMasks[cell], cell - BOARD_MASK_STRIDE);
+            }
+            if (r < BOARD_SIZE - 1)
+            {
+                SetCell(tables.neighbourMasks[cell], cell + BOARD_MASK_STRIDE);
+            }
+
+            for (int spacing = 1; spacing <= MAX_SHIP_SIZE; spacing++)
+            {
+                if ((r + c) % spacing == 0)
+                {
+                    SetCell(tables.spacingMasks[spacing], cell);
+                }
+            }
+        }
+    }
+    return tables;
+}
+
+static const ParityTables tables = BuildParityTables();
+
+/* Whole-board shifts, a shift by n moves every cell n bit positions; 0 < n < 64 */
+
+static BoardMask ShiftMaskUp(const BoardMask& mask, int n)
+{
+    BoardMask shifted = { { mask.bits[0] << n, (mask.bits[1] << n) | (mask.bits[0] >> (64 - n)) } };
+    return MaskAnd(shifted, tables.boardMask);
+}
+
+static BoardMask ShiftMaskDown(const BoardMask& mask, int n)
+{
+    BoardMask shifted = { { (mask.bits[0] >> n) | (mask.bits[1] << (64 - n)), mask.bits[1] >> n } };
+    return shifted;
+}
+
+static BoardMask StepEast(const BoardMask& mask)
+{
+    return MaskAnd(ShiftMaskUp(mask, 1), tables.notFirstColumn);        // Cells of the last column would wrap to the next row
+}
+
+static BoardMask StepWest(const BoardMask& mask)
+{
+    return MaskAnd(ShiftMaskDown(mask, 1), tables.notLastColumn);
+}
+
+static BoardMask StepSouth(const BoardMask& mask)
+{
+    return ShiftMaskUp(mask, BOARD_MASK_STRIDE);
+}
+
+static BoardMask StepNorth(const BoardMask& mask)
+{
+    return ShiftMaskDown(mask, BOARD_MASK_STRIDE);
+}
+
+static BoardMask GetNeighbours(const BoardMask& mask)
+{
+    return MaskOr(MaskOr(StepEast(mask), StepWest(mask)), MaskOr(StepSouth(mask), StepNorth(mask)));
+}
+
+static BoardMask GetLineEnds(const BoardMask& hits)                     // Cells that carry on a run of two or more hits
+{
+    BoardMask east = StepEast(MaskAnd(hits, StepEast(hits)));
+    BoardMask west = StepWest(MaskAnd(hits, StepWest(hits)));
+    BoardMask south = StepSouth(MaskAnd(hits, StepSouth(hits)));
+    BoardMask north = StepNorth(MaskAnd(hits, StepNorth(hits)));
+
+    return MaskOr(MaskOr(east, west), MaskOr(south, north));
+}
+
+static BoardMask GetUnguessedMask(const Player& player)
+{
+    return MaskAndNot(tables.boardMask, MaskOr(player.guessHitMask, player.guessMissMask));
+}
+
+void ResetParityState(Player& player)
+{
+    ParityState& state = player.parityState;
+
+    for (int size = 0; size <= MAX_SHIP_SIZE; size++)
+    {
+        state.shipsAfloat[size] = 0;
+    }
+
+    state.huntSpacing = MAX_SHIP_SIZE;
+
+    for (int i = 0; i < NUM_SHIPS; i++)                                 // Both fleets have the same make-up
+    {
+        int size = player.ships[i].shipSize;
+
+        state.shipsAfloat[size]++;
+        state.huntSpacing = size < state.huntSpacing ? size : state.huntSpacing;
+    }
+
+    state.huntMask = tables.spacingMasks[state.huntSpacing];
+    state.frontierMask = EmptyMask();
+    state.liveHitMask = EmptyMask();
+}
+
+void UpdateParityOnMiss(ParityState& state, int cell)
+{
+    ClearCell(state.huntMask, cell);
+    ClearCell(state.frontierMask, cell);
+}
+
+void UpdateParityOnHit(ParityState& state, const Player& player, int cell)
+{
+    ClearCell(state.huntMask, cell);
+    SetCell(state.liveHitMask, cell);
+
+    state.frontierMask = MaskAndNot(MaskOr(state.frontierMask, tables.neighbourMasks[cell]), MaskOr(player.guessHitMask, player.guessMissMask));
+}
+
+/*
+    The sunk ship's hits stop counting. Its neighbours only stay on the frontier if they also touch
+    another ship's hit, so the frontier is rebuilt from the hits that are left, and the hunt cells
+    are redrawn if the smallest ship afloat got bigger.
+*/
+void UpdateParityOnSunk(ParityState& state, const Player& player, const BoardMask& shipCells, int shipSize)
+{
+    BoardMask unguessed = GetUnguessedMask(player);
+
+    state.liveHitMask = MaskAndNot(state.liveHitMask, shipCells);
+    state.frontierMask = MaskAnd(GetNeighbours(state.liveHitMask), unguessed);
+
+    if (shipSize >= 1 && shipSize <= MAX_SHIP_SIZE && state.shipsAfloat[shipSize] > 0)
+    {
+        state.shipsAfloat[shipSize]--;
+    }
+
+    int spacing = state.huntSpacing;
+
+    while (spacing < MAX_SHIP_SIZE && state.shipsAfloat[spacing] == 0)
+    {
+        spacing++;
+    }
+
+    if (spacing != state.huntSpacing)
+    {
+        state.huntSpacing = spacing;
+        state.huntMask = MaskAnd(tables.spacingMasks[spacing], unguessed);
+    }
+}
+
+ShipPositionType GetParityGuess(const Player& aiPlayer)
+{
+    const ParityState& state = aiPlayer.parityState;
+    BoardMask candidates = state.frontierMask;
+
+    if (!MaskIsEmpty(candidates))
+    {
+        BoardMask lineEnds = MaskAnd(GetLineEnds(state.liveHitMask), candidates);
+
+        if (!MaskIsEmpty(lineEnds))
+        {
+            candidates = lineEnds;
+        }
+    }
+    else
+    {
+        candidates = MaskIsEmpty(state.huntMask) ? GetUnguessedMask(aiPlayer) : state.huntMask;
+    }
+
+    int numCandidates = MaskPopCount(candidates);
+
+    if (numCandidates == 0)
+    {
+        return GetRandomPosition();                                     // Board full, the game is already over
+    }
+
+    int cell = MaskNthCell(candidates, RandomInt(GetThreadRandom(), numCandidates));
+    ShipPositionType guess;
+
+    guess.row = cell / BOARD_MASK_STRIDE;
+    guess.col = cell % BOARD_MASK_STRIDE;
+
+    return guess;
+}
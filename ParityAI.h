@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef __PARITYAI_H__
+#define __PARITYAI_H__
+
+#include "Game.h"
+
+/*
+    Parity AI. A ship of length k always covers a cell with (row + col) % k == 0, so while nothing
+    is being chased it only fires on those cells for the smallest ship afloat: a checkerboard while
+    the submarine lives, every third diagonal after that. Once a shot hits it switches to target
+    mode and fires next to the unsunk hits, preferring cells that extend two hits in a row.
+
+    The hunt cells, the target frontier and the unsunk hits are bitsets in Player::parityState,
+    kept up to date from ParityStrategy's hooks (Strategy.h), so a shot is picked with a few mask
+    operations and a walk over at most the candidate count.
+*/
+
+void ResetParityState(Player& player);                                  // Fresh board, every ship of the player's fleet afloat
+void UpdateParityOnMiss(ParityState& state, int cell);
+void UpdateParityOnHit(ParityState& state, const Player& player, int cell);
+void UpdateParityOnSunk(ParityState& state, const Player& player, const BoardMask& shipCells, int shipSize);
+ShipPositionType GetParityGuess(const Player& aiPlayer);
+
+#endif
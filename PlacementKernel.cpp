@@ -0,0 +1,405 @@
+// PlacementKernel.cpp : Scalar, SSE2 and AVX2 placement heatmap kernels with runtime dispatch.
+//
+
+#include <cstring>
+#include <cstdint>
+#include "PlacementKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PLACEMENT_KERNEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PLACEMENT_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+enum
+{
+    ROW_BYTES = 16,                                                     // One row of cells, one byte per cell, padded to a 128-bit lane
+    ROW_PADDING = MAX_SHIP_SIZE - 1,                                    // Zero rows above and below so shifted row loads stay in bounds
+    PADDED_ROWS = ROW_PADDING + BOARD_SIZE + ROW_PADDING,
+    NUM_CELLS = BOARD_SIZE * BOARD_SIZE
+};
+
+static_assert(MAX_SHIP_SIZE == 5, "The SIMD kernels unroll one AND/shift per ship length up to 5");
+
+typedef void (*PlacementKernelFunction)(const uint16_t freeBits[BOARD_SIZE], const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[NUM_CELLS]);
+
+static PlacementKernelType activeKernel = PK_SCALAR;
+static PlacementKernelFunction activeFunction = nullptr;                // Set before main by the static below
+
+/* Helpers */
+
+static void GetFreeRowBits(const BoardMask& blockedMask, uint16_t freeBits[BOARD_SIZE])
+{
+    const uint16_t ROW_MASK = (1 << BOARD_SIZE) - 1;
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        int first = r * BOARD_SIZE;
+        uint64_t bits = blockedMask.bits[first >> 6] >> (first & 63);
+
+        if ((first & 63) + BOARD_SIZE > 64)                              // The row straddles the two words
+        {
+            bits |= blockedMask.bits[(first >> 6) + 1] << (64 - (first & 63));
+        }
+
+        freeBits[r] = uint16_t(~bits & ROW_MASK);
+    }
+}
+
+static uint64_t SpreadBitsToBytes(uint64_t bits)                        // Low 8 bits to 8 bytes of 0x00 / 0xFF
+{
+    uint64_t x = (bits * 0x0101010101010101ull) & 0x8040201008040201ull;
+
+    return (((x + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull) >> 7) * 0xFF;
+}
+
+static void ExpandFreeRows(const uint16_t freeBits[BOARD_SIZE], unsigned char freeRows[PADDED_ROWS * ROW_BYTES])
+{
+    memset(freeRows, 0, PADDED_ROWS * ROW_BYTES);
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        uint64_t low = SpreadBitsToBytes(freeBits[r] & 0xFF);
+        uint64_t high = SpreadBitsToBytes(freeBits[r] >> 8);
+
+        memcpy(freeRows + (ROW_PADDING + r) * ROW_BYTES, &low, 8);
+        memcpy(freeRows + (ROW_PADDING + r) * ROW_BYTES + 8, &high, 8);
+    }
+}
+
+/* Scalar Kernel */
+
+static void HeatmapScalar(const uint16_t freeBits[BOARD_SIZE], const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[NUM_CELLS])
+{
+    int counts[NUM_CELLS] = { 0 };
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        unsigned int horizontal = freeBits[r];                          // Bit c: a ship of the current size fits starting at column c
+        unsigned int vertical = freeBits[r];                            // Bit c: a ship of the current size fits starting at row r
+
+        for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+        {
+            if (size > 1)
+            {
+                horizontal &= unsigned(freeBits[r]) >> (size - 1);
+                vertical &= (r + size - 1 < BOARD_SIZE) ? freeBits[r + size - 1] : 0;
+            }
+
+            int weight = shipsAfloat[size];
+
+            if (weight == 0)
+            {
+                continue;
+            }
+
+            for (int c = 0; c < BOARD_SIZE; c++)
+            {
+                if ((horizontal >> c) & 1)
+                {
+                    for (int k = 0; k < size; k++)
+                    {
+                        counts[r * BOARD_SIZE + c + k] += weight;
+                    }
+                }
+                if ((vertical >> c) & 1)
+                {
+                    for (int k = 0; k < size; k++)
+                    {
+                        counts[(r + k) * BOARD_SIZE + c] += weight;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+    {
+        heatmap[cell] = (unsigned char)(counts[cell] > 255 ? 255 : counts[cell]);
+    }
+}
+
+#ifdef PLACEMENT_KERNEL_X86
+
+/* SSE2 Kernel */
+
+/*
+    One row per register, one byte per cell. The start masks for sizes 1..5 come from one chain of
+    ANDs (h[s] = h[s - 1] & f >> (s - 1)). Instead of summing every size's shifted masks separately,
+    t[k] = sum of the weighted masks of the sizes longer than k, and the row total is
+    t[0] + t[1] << 1 + ... + t[4] << 4. Vertical placements do the same with row offsets.
+*/
+static void HeatmapSSE2(const uint16_t freeBits[BOARD_SIZE], const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[NUM_CELLS])
+{
+    alignas(16) unsigned char freeRows[PADDED_ROWS * ROW_BYTES];
+    alignas(16) unsigned char tails[MAX_SHIP_SIZE][PADDED_ROWS * ROW_BYTES];
+    alignas(16) unsigned char totals[BOARD_SIZE * ROW_BYTES];
+
+    ExpandFreeRows(freeBits, freeRows);
+
+    __m128i weights[MAX_SHIP_SIZE + 1];
+
+    for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+    {
+        weights[size] = _mm_set1_epi8(char(shipsAfloat[size]));
+    }
+
+    memset(tails, 0, sizeof(tails));
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        const unsigned char* row = freeRows + (ROW_PADDING + r) * ROW_BYTES;
+        __m128i f = _mm_load_si128((const __m128i*)row);
+
+        __m128i h1 = f;                                                 // Horizontal starts
+        __m128i h2 = _mm_and_si128(h1, _mm_srli_si128(f, 1));
+        __m128i h3 = _mm_and_si128(h2, _mm_srli_si128(f, 2));
+        __m128i h4 = _mm_and_si128(h3, _mm_srli_si128(f, 3));
+        __m128i h5 = _mm_and_si128(h4, _mm_srli_si128(f, 4));
+
+        __m128i t4 = _mm_and_si128(h5, weights[5]);
+        __m128i t3 = _mm_adds_epu8(t4, _mm_and_si128(h4, weights[4]));
+        __m128i t2 = _mm_adds_epu8(t3, _mm_and_si128(h3, weights[3]));
+        __m128i t1 = _mm_adds_epu8(t2, _mm_and_si128(h2, weights[2]));
+        __m128i t0 = _mm_adds_epu8(t1, _mm_and_si128(h1, weights[1]));
+
+        __m128i total = t0;
+        total = _mm_adds_epu8(total, _mm_slli_si128(t1, 1));
+        total = _mm_adds_epu8(total, _mm_slli_si128(t2, 2));
+        total = _mm_adds_epu8(total, _mm_slli_si128(t3, 3));
+        total = _mm_adds_epu8(total, _mm_slli_si128(t4, 4));
+
+        _mm_store_si128((__m128i*)(totals + r * ROW_BYTES), total);
+
+        __m128i v1 = f;                                                 // Vertical starts, rows below the board are zero
+        __m128i v2 = _mm_and_si128(v1, _mm_load_si128((const __m128i*)(row + 1 * ROW_BYTES)));
+        __m128i v3 = _mm_and_si128(v2, _mm_load_si128((const __m128i*)(row + 2 * ROW_BYTES)));
+        __m128i v4 = _mm_and_si128(v3, _mm_load_si128((const __m128i*)(row + 3 * ROW_BYTES)));
+        __m128i v5 = _mm_and_si128(v4, _mm_load_si128((const __m128i*)(row + 4 * ROW_BYTES)));
+
+        __m128i u4 = _mm_and_si128(v5, weights[5]);
+        __m128i u3 = _mm_adds_epu8(u4, _mm_and_si128(v4, weights[4]));
+        __m128i u2 = _mm_adds_epu8(u3, _mm_and_si128(v3, weights[3]));
+        __m128i u1 = _mm_adds_epu8(u2, _mm_and_si128(v2, weights[2]));
+        __m128i u0 = _mm_adds_epu8(u1, _mm_and_si128(v1, weights[1]));
+
+        int offset = (ROW_PADDING + r) * ROW_BYTES;
+
+        _mm_store_si128((__m128i*)(tails[0] + offset), u0);
+        _mm_store_si128((__m128i*)(tails[1] + offset), u1);
+        _mm_store_si128((__m128i*)(tails[2] + offset), u2);
+        _mm_store_si128((__m128i*)(tails[3] + offset), u3);
+        _mm_store_si128((__m128i*)(tails[4] + offset), u4);
+    }
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+    {
+        __m128i total = _mm_load_si128((const __m128i*)(totals + r * ROW_BYTES));
+
+        for (int k = 0; k < MAX_SHIP_SIZE; k++)                         // A vertical start k rows up covers this row if longer than k
+        {
+            total = _mm_adds_epu8(total, _mm_load_si128((const __m128i*)(tails[k] + (ROW_PADDING + r - k) * ROW_BYTES)));
+        }
+
+        _mm_store_si128((__m128i*)(totals + r * ROW_BYTES), total);
+        memcpy(heatmap + r * BOARD_SIZE, totals + r * ROW_BYTES, BOARD_SIZE);
+    }
+}
+
+/* AVX2 Kernel */
+
+/*
+    Same as the SSE2 kernel with two rows per register. Byte shifts in AVX2 work within each 128-bit
+    half, so the horizontal shifts never bleed from one row into the next.
+*/
+TARGET_AVX2 static void HeatmapAVX2(const uint16_t freeBits[BOARD_SIZE], const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[NUM_CELLS])
+{
+    alignas(32) unsigned char freeRows[PADDED_ROWS * ROW_BYTES];
+    alignas(32) unsigned char tails[MAX_SHIP_SIZE][PADDED_ROWS * ROW_BYTES];
+    alignas(32) unsigned char totals[BOARD_SIZE * ROW_BYTES];
+
+    ExpandFreeRows(freeBits, freeRows);
+
+    __m256i weights[MAX_SHIP_SIZE + 1];
+
+    for (int size = 1; size <= MAX_SHIP_SIZE; size++)
+    {
+        weights[size] = _mm256_set1_epi8(char(shipsAfloat[size]));
+    }
+
+    memset(tails, 0, sizeof(tails));
+
+    for (int r = 0; r < BOARD_SIZE; r += 2)
+    {
+        const unsigned char* row = freeRows + (ROW_PADDING + r) * ROW_BYTES;
+        __m256i f = _mm256_loadu_si256((const __m256i*)row);
+
+        __m256i h1 = f;
+        __m256i h2 = _mm256_and_si256(h1, _mm256_srli_si256(f, 1));
+        __m256i h3 = _mm256_and_si256(h2, _mm256_srli_si256(f, 2));
+        __m256i h4 = _mm256_and_si256(h3, _mm256_srli_si256(f, 3));
+        __m256i h5 = _mm256_and_si256(h4, _mm256_srli_si256(f, 4));
+
+        __m256i t4 = _mm256_and_si256(h5, weights[5]);
+        __m256i t3 = _mm256_adds_epu8(t4, _mm256_and_si256(h4, weights[4]));
+        __m256i t2 = _mm256_adds_epu8(t3, _mm256_and_si256(h3, weights[3]));
+        __m256i t1 = _mm256_adds_epu8(t2, _mm256_and_si256(h2, weights[2]));
+        __m256i t0 = _mm256_adds_epu8(t1, _mm256_and_si256(h1, weights[1]));
+
+        __m256i total = t0;
+        total = _mm256_adds_epu8(total, _mm256_slli_si256(t1, 1));
+        total = _mm256_adds_epu8(total, _mm256_slli_si256(t2, 2));
+        total = _mm256_adds_epu8(total, _mm256_slli_si256(t3, 3));
+        total = _mm256_adds_epu8(total, _mm256_slli_si256(t4, 4));
+
+        _mm256_storeu_si256((__m256i*)(totals + r * ROW_BYTES), total);
+
+        __m256i v1 = f;
+        __m256i v2 = _mm256_and_si256(v1, _mm256_loadu_si256((const __m256i*)(row + 1 * ROW_BYTES)));
+        __m256i v3 = _mm256_and_si256(v2, _mm256_loadu_si256((const __m256i*)(row + 2 * ROW_BYTES)));
+        __m256i v4 = _mm256_and_si256(v3, _mm256_loadu_si256((const __m256i*)(row + 3 * ROW_BYTES)));
+        __m256i v5 = _mm256_and_si256(v4, _mm256_loadu_si256((const __m256i*)(row + 4 * ROW_BYTES)));
+
+        __m256i u4 = _mm256_and_si256(v5, weights[5]);
+        __m256i u3 = _mm256_adds_epu8(u4, _mm256_and_si256(v4, weights[4]));
+        __m256i u2 = _mm256_adds_epu8(u3, _mm256_and_si256(v3, weights[3]));
+        __m256i u1 = _mm256_adds_epu8(u2, _mm256_and_si256(v2, weights[2]));
+        __m256i u0 = _mm256_adds_epu8(u1, _mm256_and_si256(v1, weights[1]));
+
+        int offset = (ROW_PADDING + r) * ROW_BYTES;
+
+        _mm256_storeu_si256((__m256i*)(tails[0] + offset), u0);
+        _mm256_storeu_si256((__m256i*)(tails[1] + offset), u1);
+        _mm256_storeu_si256((__m256i*)(tails[2] + offset), u2);
+        _mm256_storeu_si256((__m256i*)(tails[3] + offset), u3);
+        _mm256_storeu_si256((__m256i*)(tails[4] + offset), u4);
+    }
+
+    for (int r = 0; r < BOARD_SIZE; r += 2)
+    {
+        __m256i total = _mm256_loadu_si256((const __m256i*)(totals + r * ROW_BYTES));
+
+        for (int k = 0; k < MAX_SHIP_SIZE; k++)
+        {
+            total = _mm256_adds_epu8(total, _mm256_loadu_si256((const __m256i*)(tails[k] + (ROW_PADDING + r - k) * ROW_BYTES)));
+        }
+
+        _mm256_storeu_si256((__m256i*)(totals + r * ROW_BYTES), total);
+        memcpy(heatmap + r * BOARD_SIZE, totals + r * ROW_BYTES, BOARD_SIZE);
+        memcpy(heatmap + (r + 1) * BOARD_SIZE, totals + (r + 1) * ROW_BYTES, BOARD_SIZE);
+    }
+}
+
+static bool CpuSupportsAVX2()
+{
+#ifdef _MSC_VER
+    int info[4];
+
+    __cpuid(info, 0);
+
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    __cpuid(info, 1);
+
+    bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 6) == 6);   // OSXSAVE, and the OS saves XMM and YMM state
+
+    __cpuidex(info, 7, 0);
+
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+/* Dispatch */
+
+static bool IsKernelSupported(PlacementKernelType kernel)
+{
+    switch (kernel)
+    {
+    case PK_SCALAR:
+        return true;
+#ifdef PLACEMENT_KERNEL_X86
+    case PK_SSE2:
+        return true;                                                    // Part of every x86-64 CPU
+    case PK_AVX2:
+        return CpuSupportsAVX2();
+#endif
+    default:
+        return false;
+    }
+}
+
+bool SetPlacementKernel(PlacementKernelType kernel)
+{
+    if (kernel == PK_AUTO)
+    {
+        kernel = IsKernelSupported(PK_AVX2) ? PK_AVX2 : (IsKernelSupported(PK_SSE2) ? PK_SSE2 : PK_SCALAR);
+    }
+
+    if (!IsKernelSupported(kernel))
+    {
+        return false;
+    }
+
+    switch (kernel)
+    {
+#ifdef PLACEMENT_KERNEL_X86
+    case PK_SSE2:
+        activeFunction = HeatmapSSE2;
+        break;
+    case PK_AVX2:
+        activeFunction = HeatmapAVX2;
+        break;
+#endif
+    default:
+        activeFunction = HeatmapScalar;
+        break;
+    }
+
+    activeKernel = kernel;
+    return true;
+}
+
+static const bool kernelSelected = SetPlacementKernel(PK_AUTO);       // Detect the CPU once at startup, no check per call
+
+PlacementKernelType GetPlacementKernel()
+{
+    return activeKernel;
+}
+
+const char* GetPlacementKernelName(PlacementKernelType kernel)
+{
+    switch (kernel)
+    {
+    case PK_SCALAR:
+        return "scalar";
+    case PK_SSE2:
+        return "sse2";
+    case PK_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+
+void ComputePlacementHeatmap(const BoardMask& blockedMask, const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[BOARD_SIZE * BOARD_SIZE])
+{
+    uint16_t freeBits[BOARD_SIZE];
+
+    GetFreeRowBits(blockedMask, freeBits);
+    activeFunction(freeBits, shipsAfloat, heatmap);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifndef __PLACEMENTKERNEL_H__
+#define __PLACEMENTKERNEL_H__
+
+#include "Game.h"
+
+/*
+    Placement heatmap: for every cell, how many legal horizontal and vertical placements of the
+    remaining fleet cover it. A placement is legal when none of its cells is blocked (misses and the
+    cells of sunk ships). Each ship size counts once per ship of that size still afloat.
+
+    All ship sizes are done in one pass with shifted-mask ANDs. The AVX2 kernel handles two rows per
+    register, the SSE2 kernel one row per register, and the scalar kernel works on row bitmasks. The
+    fastest kernel the CPU supports is chosen at startup.
+*/
+
+enum PlacementKernelType
+{
+    PK_AUTO = 0,                                                        // Pick by CPU feature detection
+    PK_SCALAR,
+    PK_SSE2,
+    PK_AVX2
+};
+
+void ComputePlacementHeatmap(const BoardMask& blockedMask, const unsigned char shipsAfloat[MAX_SHIP_SIZE + 1], unsigned char heatmap[BOARD_SIZE * BOARD_SIZE]);
+
+bool SetPlacementKernel(PlacementKernelType kernel);                    // False if this CPU can't run it
+PlacementKernelType GetPlacementKernel();                               // The kernel in use, never PK_AUTO
+const char* GetPlacementKernelName(PlacementKernelType kernel);
+
+#endif
@@ -0,0 +1,166 @@
+// Profiler.cpp : Per-thread phase counters and the --stats report.
+//
+
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#include <cstring>
+#include "Profiler.h"
+
+using namespace std;
+
+static mutex registryMutex;
+static vector<ProfileCounters*> registry;                               // Every thread's counters, never freed so they outlive their thread
+
+static const char* phaseNames[NUM_PROFILE_PHASES] =
+{
+    "SetupBoards",
+    "GetAIGuess",
+    "Guess loop",
+    "Guess retries",
+    "UpdateBoards",
+    "DrawBoards",
+    "Input wait"
+};
+
+static ProfileCounters& GetThreadCounters()
+{
+    thread_local ProfileCounters* counters = nullptr;
+
+    if (counters == nullptr)
+    {
+        counters = new ProfileCounters;
+        memset(counters, 0, sizeof(ProfileCounters));
+
+        lock_guard<mutex> lock(registryMutex);
+
+        registry.push_back(counters);
+    }
+    return *counters;
+}
+
+static int GetBucketIndex(long long value)
+{
+    if (value < 4)
+    {
+        return value > 0 ? int(value) : 0;
+    }
+
+    int octave = 2;
+
+    while (octave < 62 && (value >> (octave + 1)) != 0)
+    {
+        octave++;
+    }
+
+    return 4 * (octave - 1) + int((value >> (octave - 2)) & 3);         // The two bits below the leading one pick the quarter
+}
+
+static double GetBucketMiddle(int index)
+{
+    if (index < 4)
+    {
+        return index;
+    }
+
+    int octave = index / 4 + 1;
+    double width = double(1LL << (octave - 2));
+
+    return (4 + index % 4) * width + (width - 1) / 2;
+}
+
+static double GetPercentile(const long long buckets[], long long count, double fraction)
+{
+    long long rank = (long long)(fraction * (count - 1));
+    long long seen = 0;
+
+    for (int i = 0; i < NUM_PROFILE_BUCKETS; i++)
+    {
+        seen += buckets[i];
+
+        if (seen > rank)
+        {
+            return GetBucketMiddle(i);
+        }
+    }
+    return GetBucketMiddle(NUM_PROFILE_BUCKETS - 1);
+}
+
+void RecordProfileValue(ProfilePhaseType phase, long long value)
+{
+    ProfileCounters& counters = GetThreadCounters();
+
+    counters.counts[phase]++;
+    counters.totals[phase] += value;
+    counters.buckets[phase][GetBucketIndex(value)]++;
+}
+
+bool IsProfilingEnabled()
+{
+#ifdef BATTLESHIP_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PrintProfileStats()
+{
+    if (!IsProfilingEnabled())
+    {
+        cout << endl << "--stats: this build has no profiling, configure with -DBATTLESHIP_PROFILE=ON" << endl;
+        return;
+    }
+
+    static ProfileCounters total;
+
+    memset(&total, 0, sizeof(total));
+
+    {
+        lock_guard<mutex> lock(registryMutex);
+
+        for (size_t t = 0; t < registry.size(); t++)
+        {
+            for (int phase = 0; phase < NUM_PROFILE_PHASES; phase++)
+            {
+                total.counts[phase] += registry[t]->counts[phase];
+                total.totals[phase] += registry[t]->totals[phase];
+
+                for (int i = 0; i < NUM_PROFILE_BUCKETS; i++)
+                {
+                    total.buckets[phase][i] += registry[t]->buckets[phase][i];
+                }
+            }
+        }
+    }
+
+    cout << endl << "Phase timings (percentiles to within 1/8 of the value)" << endl;
+    cout << "  " << left << setw(16) << "Phase" << right << setw(10) << "Count" << setw(14) << "Total" << setw(12) << "Mean" << setw(12) << "p50" << setw(12) << "p99" << endl;
+    cout << fixed;
+
+    for (int phase = 0; phase < NUM_PROFILE_PHASES; phase++)
+    {
+        long long count = total.counts[phase];
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        cout << "  " << left << setw(16) << phaseNames[phase] << right << setw(10) << count;
+
+        if (phase == PP_GUESS_RETRIES)                                  // A count of guesses, not a time
+        {
+            cout << setprecision(0) << setw(14) << total.totals[phase] << setprecision(2) << setw(12) << double(total.totals[phase]) / count;
+            cout << setprecision(1) << setw(12) << GetPercentile(total.buckets[phase], count, 0.5) << setw(12) << GetPercentile(total.buckets[phase], count, 0.99) << endl;
+        }
+        else
+        {
+            cout << setprecision(3) << setw(11) << total.totals[phase] * 1e-6 << "ms" << setw(10) << total.totals[phase] * 1e-3 / count << "us";
+            cout << setw(10) << GetPercentile(total.buckets[phase], count, 0.5) * 1e-3 << "us" << setw(10) << GetPercentile(total.buckets[phase], count, 0.99) * 1e-3 << "us" << endl;
+        }
+    }
+
+    cout.copyfmt(ios(nullptr));                                         // Back to the default number formatting
+}
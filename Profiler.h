@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+/*
+    Phase timing for the game loop. PROFILE_SCOPE(phase) times the rest of the enclosing block and
+    PROFILE_VALUE(phase, value) records a plain number, such as the retries a turn needed. Both
+    write into counters owned by the calling thread, so nothing is shared until PrintProfileStats
+    adds the threads up. Each phase keeps a count, a total and a log-scale histogram (four buckets
+    per power of two) that the percentiles are read from.
+
+    The macros only do something when BATTLESHIP_PROFILE is defined (the CMake option of the same
+    name). Without it they expand to nothing and none of this is compiled in.
+*/
+
+enum ProfilePhaseType
+{
+    PP_SETUP_BOARDS = 0,
+    PP_AI_GUESS,                                                        // One GetAIGuess call
+    PP_GUESS_LOOP,                                                      // Getting a valid guess, retries and human input included
+    PP_GUESS_RETRIES,                                                   // Value: guesses rejected before the valid one, per turn
+    PP_UPDATE_BOARDS,
+    PP_DRAW_BOARDS,
+    PP_INPUT_WAIT,                                                      // Waiting on the keyboard
+    NUM_PROFILE_PHASES
+};
+
+enum
+{
+    NUM_PROFILE_BUCKETS = 256                                           // Four per power of two, enough for any 64-bit value
+};
+
+struct ProfileCounters                                                  // One per thread
+{
+    long long counts[NUM_PROFILE_PHASES];
+    long long totals[NUM_PROFILE_PHASES];                               // Nanoseconds for timed phases
+    long long buckets[NUM_PROFILE_PHASES][NUM_PROFILE_BUCKETS];
+};
+
+void RecordProfileValue(ProfilePhaseType phase, long long value);
+bool IsProfilingEnabled();                                              // Whether this build was made with BATTLESHIP_PROFILE
+void PrintProfileStats();
+
+#ifdef BATTLESHIP_PROFILE
+
+#include <chrono>
+
+struct ScopedProfileTimer
+{
+    ProfilePhaseType phase;
+    std::chrono::steady_clock::time_point start;
+
+    explicit ScopedProfileTimer(ProfilePhaseType timedPhase) : phase(timedPhase), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedProfileTimer()
+    {
+        RecordProfileValue(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+};
+
+#define PROFILE_CONCATENATE_INNER(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_INNER(a, b)
+#define PROFILE_SCOPE(phase) ScopedProfileTimer PROFILE_CONCATENATE(profileTimer, __LINE__)(phase)
+#define PROFILE_VALUE(phase, value) RecordProfileValue(phase, value)
+
+#else
+
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_VALUE(phase, value) ((void)(value))                     // Still a use of value, so counters kept for it do not warn
+
+#endif
+
+#endif
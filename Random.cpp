@@ -0,0 +1,80 @@
+// Random.cpp : xoshiro256** generator with one state per thread.
+//
+
+#include "Random.h"
+
+static thread_local RandomState threadRandom = { { 0x9E3779B97F4A7C15ull, 0xBF58476D1CE4E5B9ull, 0x94D049BB133111EBull, 0x2545F4914F6CDD1Dull } };
+
+static uint64_t SplitMix64(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t RotateLeft(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+void SeedRandom(RandomState& state, uint64_t seed)
+{
+    for (int i = 0; i < 4; i++)                                          // SplitMix64 spreads even small seeds over all 256 bits
+    {
+        state.s[i] = SplitMix64(seed);
+    }
+}
+
+uint64_t NextRandom(RandomState& state)
+{
+    uint64_t* s = state.s;
+    uint64_t result = RotateLeft(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = RotateLeft(s[3], 45);
+
+    return result;
+}
+
+/*
+    Lemire's multiply-shift: the top 32 bits of draw * bound are in [0, bound). Taken alone that
+    favours some results slightly, so the few draws whose low 32 bits fall under 2^32 mod bound are
+    thrown away. The modulo for that threshold is only worked out when the low bits are small enough
+    to need it, so most calls are one multiply.
+*/
+int RandomInt(RandomState& state, int bound)
+{
+    uint64_t range = uint64_t(uint32_t(bound));
+    uint64_t product = (NextRandom(state) >> 32) * range;
+    uint32_t low = uint32_t(product);
+
+    if (low < range)
+    {
+        uint32_t threshold = uint32_t(0x100000000ull % range);
+
+        while (low < threshold)
+        {
+            product = (NextRandom(state) >> 32) * range;
+            low = uint32_t(product);
+        }
+    }
+
+    return int(product >> 32);
+}
+
+RandomState& GetThreadRandom()
+{
+    return threadRandom;
+}
+
+void SeedThreadRandom(uint64_t seed)
+{
+    SeedRandom(threadRandom, seed);
+}
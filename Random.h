@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef __RANDOM_H__
+#define __RANDOM_H__
+
+#include <cstdint>
+
+/*
+    Seedable xoshiro256** generator. Every thread owns its own state (GetThreadRandom), so
+    games on different threads never share a generator and a game seeded the same way always
+    plays out the same way.
+*/
+
+struct RandomState
+{
+    uint64_t s[4];
+};
+
+void SeedRandom(RandomState& state, uint64_t seed);
+uint64_t NextRandom(RandomState& state);
+int RandomInt(RandomState& state, int bound);                           // 0 <= result < bound, every value equally likely
+
+RandomState& GetThreadRandom();                                         // The calling thread's generator
+void SeedThreadRandom(uint64_t seed);
+
+#endif
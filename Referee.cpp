@@ -0,0 +1,506 @@
+// Referee.cpp : Matches between external engines run as child processes.
+//
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "Referee.h"
+#include "Input.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+using namespace std;
+
+enum
+{
+    STARTUP_TIME_FACTOR = 10                                            // The handshake also covers starting the process
+};
+
+enum MoveOutcomeType
+{
+    MO_OK = 0,
+    MO_ILLEGAL,                                                         // Answered in time, but not a legal move
+    MO_TIMEOUT,                                                         // Late or no answer, the engine is restarted
+};
+
+void FormatProtocolCell(int row, int col, char text[4])
+{
+    int length = 0;
+
+    text[length++] = char('A' + row);
+
+    if (col + 1 >= 10)
+    {
+        text[length++] = char('0' + (col + 1) / 10);
+    }
+
+    text[length++] = char('0' + (col + 1) % 10);
+    text[length] = '\0';
+}
+
+void FormatProtocolFleet(const Player& player, char text[], int textSize)
+{
+    int length = 0;
+
+    text[0] = '\0';
+
+    for (int i = 0; i < NUM_SHIPS && length < textSize; i++)
+    {
+        const Ship& ship = player.ships[i];
+        char cell[4];
+
+        FormatProtocolCell(ship.shipPosition.row, ship.shipPosition.col, cell);
+        length += snprintf(text + length, size_t(textSize - length), "%s%s %c", i > 0 ? " " : "", cell, ship.shipOrientation == SO_VERTICAL ? 'V' : 'H');
+    }
+}
+
+bool ParseProtocolFleet(const char* line, Player& player)
+{
+    char text[MAX_PROTOCOL_LINE];
+    char* tokens[2 * NUM_SHIPS + 1];
+    int numTokens = 0;
+
+    snprintf(text, sizeof(text), "%s", line);
+
+    for (char* next = text; *next != '\0' && numTokens < 2 * NUM_SHIPS + 1;)   // Split on blanks in place
+    {
+        while (*next == ' ' || *next == '\t')
+        {
+            *next++ = '\0';
+        }
+        if (*next == '\0')
+        {
+            break;
+        }
+
+        tokens[numTokens++] = next;
+
+        while (*next != '\0' && *next != ' ' && *next != '\t')
+        {
+            next++;
+        }
+    }
+
+    int next = 0;
+
+    for (int i = 0; i < NUM_SHIPS; i++)
+    {
+        MoveInput move;
+        char placement[MAX_PROTOCOL_LINE];
+
+        if (next >= numTokens)
+        {
+            return false;
+        }
+
+        MoveParseType type = ParseMove(tokens[next], BOARD_SIZE, BOARD_SIZE, move);    // "A1H" in one token, or "A1" then "H"
+
+        if (type == MP_CELL && next + 1 < numTokens)
+        {
+            snprintf(placement, sizeof(placement), "%s %s", tokens[next], tokens[next + 1]);
+            type = ParseMove(placement, BOARD_SIZE, BOARD_SIZE, move);
+            next++;
+        }
+        next++;
+
+        if (type != MP_CELL_AND_ORIENTATION)
+        {
+            return false;
+        }
+
+        ShipPositionType position;
+        ShipOrientationType orientation = move.orientation == 'V' ? SO_VERTICAL : SO_HORIZONTAL;
+
+        position.row = move.row;
+        position.col = move.col;
+
+        if (!IsValidPlacement(player, player.ships[i], position, orientation))
+        {
+            return false;
+        }
+
+        PlaceShipOnBoard(player, player.ships[i], position, orientation);
+    }
+
+    return next == numTokens;
+}
+
+void FormatShotResult(const Player& target, ShipType type, char text[], int textSize)
+{
+    if (type == ST_NONE)
+    {
+        snprintf(text, size_t(textSize), "result miss");
+    }
+    else if (IsSunk(target, target.ships[type - 1]))
+    {
+        const Ship& ship = target.ships[type - 1];
+        char cell[4];
+
+        FormatProtocolCell(ship.shipPosition.row, ship.shipPosition.col, cell);
+        snprintf(text, size_t(textSize), "result sunk %d %s %c", int(type), cell, ship.shipOrientation == SO_VERTICAL ? 'V' : 'H');
+    }
+    else
+    {
+        snprintf(text, size_t(textSize), "result hit");
+    }
+}
+
+#ifdef _WIN32
+
+bool RunReferee(int numGames, const char* const commands[2], int moveMilliseconds, RefereeReport& report)
+{
+    (void)numGames;
+    (void)commands;
+    (void)moveMilliseconds;
+
+    memset(&report, 0, sizeof(report));
+
+    cout << "The referee needs fork and pipes, it is not available on Windows" << endl;
+    return false;
+}
+
+#else
+
+struct EngineProcess
+{
+    const char* command;                                                // Run with /bin/sh -c
+    pid_t pid;
+    int toEngine;                                                       // Write end of the engine's stdin
+    InputReader fromEngine;                                             // Read end of the engine's stdout
+};
+
+static EngineProcess engines[2];                                        // 64 KB read buffers, kept out of the stack
+
+static void SetCloseOnExec(int fd)                                      // So the second engine does not inherit the first one's pipes
+{
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+static bool SendLine(EngineProcess& engine, const char* line)
+{
+    char buffer[MAX_PROTOCOL_LINE + 1];
+    int length = snprintf(buffer, sizeof(buffer), "%s\n", line);
+
+    for (int written = 0; written < length;)
+    {
+        ssize_t count = write(engine.toEngine, buffer + written, size_t(length - written));
+
+        if (count <= 0)
+        {
+            return false;                                               // The engine is gone, the next read notices
+        }
+        written += int(count);
+    }
+    return true;
+}
+
+static void StopEngine(EngineProcess& engine)
+{
+    if (engine.pid <= 0)
+    {
+        return;
+    }
+
+    SendLine(engine, "quit");
+    close(engine.toEngine);
+    close(engine.fromEngine.fd);
+
+    for (int wait = 0; wait < 20; wait++)                               // A well-behaved engine exits right away, give it 100 ms
+    {
+        if (waitpid(engine.pid, nullptr, WNOHANG) == engine.pid)
+        {
+            engine.pid = -1;
+            return;
+        }
+        usleep(5000);
+    }
+
+    kill(engine.pid, SIGKILL);
+    waitpid(engine.pid, nullptr, 0);
+    engine.pid = -1;
+}
+
+static bool StartEngine(EngineProcess& engine, EngineStats& stats, int moveMilliseconds)
+{
+    int input[2];
+    int output[2];
+
+    if (pipe(input) != 0)
+    {
+        return false;
+    }
+    if (pipe(output) != 0)
+    {
+        close(input[0]);
+        close(input[1]);
+        return false;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        SetCloseOnExec(input[i]);
+        SetCloseOnExec(output[i]);
+    }
+
+    cout.flush();                                                       // Or the child would write our buffered output again
+
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        dup2(input[0], 0);                                              // dup2 clears close-on-exec on the copies
+        dup2(output[1], 1);
+        execl("/bin/sh", "sh", "-c", engine.command, (char*)nullptr);
+        _exit(127);
+    }
+
+    close(input[0]);
+    close(output[1]);
+
+    if (pid < 0)
+    {
+        close(input[1]);
+        close(output[0]);
+        return false;
+    }
+
+    engine.pid = pid;
+    engine.toEngine = input[1];
+    InitializeInputReader(engine.fromEngine, output[0]);
+
+    char hello[MAX_PROTOCOL_LINE];
+    char line[MAX_PROTOCOL_LINE];
+
+    snprintf(hello, sizeof(hello), "battleship %d", PROTOCOL_VERSION);
+
+    if (!SendLine(engine, hello) || ReadInputLineWithin(engine.fromEngine, line, sizeof(line), moveMilliseconds * STARTUP_TIME_FACTOR) != IR_LINE || strncmp(line, "ready", 5) != 0)
+    {
+        StopEngine(engine);
+        return false;
+    }
+
+    const char* name = line + 5;
+
+    while (*name == ' ')
+    {
+        name++;
+    }
+
+    snprintf(stats.name, sizeof(stats.name), "%.*s", MAX_ENGINE_NAME - 1, *name != '\0' ? name : engine.command);
+    return true;
+}
+
+static MoveOutcomeType RequestMove(EngineProcess& engine, EngineStats& stats, const char* request, char line[], int moveMilliseconds)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    if (!SendLine(engine, request) || ReadInputLineWithin(engine.fromEngine, line, MAX_PROTOCOL_LINE, moveMilliseconds) != IR_LINE)
+    {
+        stats.timeouts++;
+        return MO_TIMEOUT;
+    }
+
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    stats.moves++;
+    stats.totalMilliseconds += milliseconds;
+
+    if (milliseconds > stats.maxMilliseconds)
+    {
+        stats.maxMilliseconds = milliseconds;
+    }
+    return MO_OK;
+}
+
+/*
+    One game. first is the engine that shoots first. Returns the winner, and sets needsRestart for
+    an engine that timed out.
+*/
+static int PlayRefereeGame(int first, int moveMilliseconds, RefereeReport& report, bool needsRestart[2])
+{
+    static const char* playerNames[2] = { "EngineA", "EngineB" };
+    Player players[2];
+    char line[MAX_PROTOCOL_LINE];
+    int loser = -1;
+    bool isForfeit = false;
+
+    for (int e = 0; e < 2 && loser < 0; e++)
+    {
+        InitializePlayer(players[e], playerNames[e]);
+        players[e].playerType = PT_AI;
+        ClearBoards(players[e]);
+
+        MoveOutcomeType outcome = RequestMove(engines[e], report.engines[e], "place", line, moveMilliseconds);
+
+        if (outcome == MO_OK && !ParseProtocolFleet(line, players[e]))
+        {
+            outcome = MO_ILLEGAL;
+        }
+        if (outcome != MO_OK)
+        {
+            loser = e;
+            isForfeit = true;
+            needsRestart[e] = outcome == MO_TIMEOUT;
+        }
+    }
+
+    int current = first;
+    int turns = 0;
+
+    while (loser < 0)
+    {
+        Player& shooter = players[current];
+        Player& target = players[1 - current];
+        MoveInput move;
+
+        MoveOutcomeType outcome = RequestMove(engines[current], report.engines[current], "shoot", line, moveMilliseconds);
+
+        if (outcome == MO_OK && (ParseMove(line, BOARD_SIZE, BOARD_SIZE, move) != MP_CELL || GetGuessAt(shooter, move.row, move.col) != GT_NONE))
+        {
+            outcome = MO_ILLEGAL;                                       // Not a cell, or one it already fired at
+        }
+        if (outcome != MO_OK)
+        {
+            loser = current;
+            isForfeit = true;
+            needsRestart[current] = outcome == MO_TIMEOUT;
+            break;
+        }
+
+        ShipPositionType guess;
+        char cell[4];
+        char message[MAX_PROTOCOL_LINE];
+
+        guess.row = move.row;
+        guess.col = move.col;
+
+        ShipType type = ResolveShot(guess, shooter, target);                // The referee only keeps the rules, the engines play
+
+        turns++;
+
+        FormatShotResult(target, type, message, sizeof(message));
+        SendLine(engines[current], message);
+
+        FormatProtocolCell(guess.row, guess.col, cell);
+        snprintf(message, sizeof(message), "incoming %s", cell);
+        SendLine(engines[1 - current], message);
+
+        if (AreAllShipsSunk(target))
+        {
+            loser = 1 - current;
+            break;
+        }
+
+        current = 1 - current;
+    }
+
+    if (isForfeit)
+    {
+        report.engines[loser].forfeits++;
+    }
+
+    report.totalTurns += turns;
+    return 1 - loser;
+}
+
+bool RunReferee(int numGames, const char* const commands[2], int moveMilliseconds, RefereeReport& report)
+{
+    memset(&report, 0, sizeof(report));
+
+    signal(SIGPIPE, SIG_IGN);                                           // A dead engine shows up as a failed write, not a signal
+
+    for (int e = 0; e < 2; e++)
+    {
+        engines[e].command = commands[e];
+        engines[e].pid = -1;
+
+        if (!StartEngine(engines[e], report.engines[e], moveMilliseconds))
+        {
+            cout << "Could not start engine: " << commands[e] << endl;
+
+            if (e == 1)
+            {
+                StopEngine(engines[0]);
+            }
+            return false;
+        }
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int game = 0; game < numGames; game++)
+    {
+        bool needsRestart[2] = { false, false };
+        int winner = PlayRefereeGame(game & 1, moveMilliseconds, report, needsRestart);
+
+        report.gamesPlayed++;
+        report.engines[winner].wins++;
+
+        for (int e = 0; e < 2; e++)
+        {
+            if (needsRestart[e])
+            {
+                StopEngine(engines[e]);
+                report.engines[e].restarts++;
+
+                if (!StartEngine(engines[e], report.engines[e], moveMilliseconds))
+                {
+                    cout << "Could not restart engine: " << commands[e] << endl;
+                    StopEngine(engines[1 - e]);
+                    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    return false;
+                }
+            }
+            else
+            {
+                SendLine(engines[e], e == winner ? "end win" : "end loss");
+            }
+        }
+    }
+
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    StopEngine(engines[0]);
+    StopEngine(engines[1]);
+    return true;
+}
+
+#endif
+
+void PrintRefereeReport(const RefereeReport& report)
+{
+    if (report.gamesPlayed == 0)
+    {
+        cout << "No games were played." << endl;
+        return;
+    }
+
+    cout << "Games played:   " << report.gamesPlayed << endl;
+
+    for (int e = 0; e < 2; e++)
+    {
+        const EngineStats& stats = report.engines[e];
+
+        cout << (e == 0 ? "Engine A:       " : "Engine B:       ") << stats.name << endl;
+        cout << "  Wins:         " << stats.wins << " (" << 100.0 * stats.wins / report.gamesPlayed << "%), " << stats.forfeits << " lost by forfeit" << endl;
+        cout << "  Move time:    avg " << (stats.moves > 0 ? stats.totalMilliseconds / stats.moves : 0.0) << " ms, max " << stats.maxMilliseconds << " ms over " << stats.moves << " moves" << endl;
+        cout << "  Timeouts:     " << stats.timeouts << ", restarts " << stats.restarts << endl;
+    }
+
+    cout << "Turns per game: avg " << double(report.totalTurns) / report.gamesPlayed << endl;
+    cout << "Elapsed:        " << report.elapsedSeconds << " s";
+
+    if (report.elapsedSeconds > 0)
+    {
+        cout << " (" << report.gamesPlayed / report.elapsedSeconds << " games/sec)";
+    }
+
+    cout << endl;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#ifndef __REFEREE_H__
+#define __REFEREE_H__
+
+#include "Game.h"
+
+/*
+    Referee for external engines. Two engines run as child processes for the whole match and
+    play any number of games back to back; the referee owns the boards, checks every move and
+    keeps the score. Messages are single lines of text over the engines' stdin and stdout.
+
+    Referee to engine                   Engine answers
+        battleship 1                        ready <name>
+        place                               its fleet, ships in order 5 4 3 3 2: "A1 H C1 H E1 V G8 V J9 H"
+        shoot                               a cell: "B7"
+        result miss                         -
+        result hit                          -
+        result sunk <ship> <cell> <H|V>     -   ship 1-5 in the order above, with the cell and
+                                                orientation it was placed at
+        incoming <cell>                     -   the other engine fired at this cell
+        end win | end loss                  -   the next game starts with another place
+        quit                                -   the engine should exit
+
+    Every answer must arrive within the move time limit. An illegal fleet or shot loses the game;
+    so does a late or missing answer, and the engine is then restarted, since it may still send
+    the late answer. Engines take turns going first from game to game.
+
+    Battleship --bot STRATEGY speaks the engine side of this protocol with one of the built-in
+    AIs, see Bot.h. Spawning engines needs fork and pipes, so the referee is POSIX only.
+*/
+
+enum
+{
+    PROTOCOL_VERSION = 1,
+    MAX_ENGINE_NAME = 32,
+    MAX_PROTOCOL_LINE = 128                                             // Longest message either side sends
+};
+
+struct EngineStats
+{
+    char name[MAX_ENGINE_NAME];                                         // From the engine's ready line
+    long long moves;                                                    // Placements and shots answered in time
+    double totalMilliseconds;
+    double maxMilliseconds;
+    long long wins;
+    long long forfeits;                                                 // Games lost to an illegal, late or missing answer
+    long long timeouts;
+    long long restarts;
+};
+
+struct RefereeReport
+{
+    long long gamesPlayed;
+    long long totalTurns;
+    double elapsedSeconds;
+    EngineStats engines[2];
+};
+
+bool RunReferee(int numGames, const char* const commands[2], int moveMilliseconds, RefereeReport& report);   // False if an engine could not be started
+void PrintRefereeReport(const RefereeReport& report);
+
+/* Messages, shared with the bot and the server */
+
+void FormatProtocolCell(int row, int col, char text[4]);                // "B7", "J10"
+void FormatProtocolFleet(const Player& player, char text[], int textSize);  // The answer to place
+bool ParseProtocolFleet(const char* text, Player& player);              // Places the ships on a cleared board, false at the first bad one
+void FormatShotResult(const Player& target, ShipType type, char text[], int textSize);   // "result ..." for the ResolveShot outcome on target
+
+#endif
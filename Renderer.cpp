@@ -0,0 +1,220 @@
+// Renderer.cpp : Character grid frames sent to the terminal as one write of ANSI-addressed changes.
+//
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include "Renderer.h"
+#include "Terminal.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+enum
+{
+    MERGE_GAP = 6                                                       // Resend up to this many unchanged cells rather than start a new escape
+};
+
+static void WriteToTerminal(const char* data, int length)
+{
+    cout.flush();                                                       // Anything already printed must land before the frame
+    fflush(stdout);
+
+    while (length > 0)
+    {
+#ifdef _WIN32
+        int written = _write(1, data, (unsigned int)length);
+#else
+        int written = (int)write(STDOUT_FILENO, data, (size_t)length);
+#endif
+        if (written <= 0)
+        {
+            return;
+        }
+
+        data += written;
+        length -= written;
+    }
+}
+
+static int AppendText(FrameBuffer& frame, int length, const char* text, int count)
+{
+    memcpy(frame.output + length, text, count);
+    return length + count;
+}
+
+static int AppendCursorMove(FrameBuffer& frame, int length, int row, int col)   // Rows and columns start at 0
+{
+    return length + snprintf(frame.output + length, FRAME_OUTPUT_SIZE - length, "\x1b[%d;%dH", row + 1, col + 1);
+}
+
+static int RowTextLength(const char row[FRAME_MAX_COLS])                // Without trailing spaces
+{
+    int length = FRAME_MAX_COLS;
+
+    while (length > 0 && row[length - 1] == ' ')
+    {
+        length--;
+    }
+    return length;
+}
+
+static int BuildFullFrame(FrameBuffer& frame, bool useAnsi)
+{
+    int length = useAnsi ? AppendText(frame, 0, "\x1b[H\x1b[2J", 7) : 0;
+
+    for (int r = 0; r < frame.numRows; r++)
+    {
+        length = AppendText(frame, length, frame.cells[r], RowTextLength(frame.cells[r]));
+        frame.output[length++] = '\n';
+    }
+    return length;
+}
+
+/*
+    Only the runs of cells that differ from the screen, each preceded by a cursor move. Returns -1
+    if the changes would not fit the output buffer, in which case a full frame is cheaper anyway.
+*/
+static int BuildFrameDiff(FrameBuffer& frame)
+{
+    const int ESCAPE_SPACE = 16;
+    int length = 0;
+
+    for (int r = 0; r < frame.numRows; r++)
+    {
+        const char* next = frame.cells[r];
+        const char* shown = frame.shown[r];
+        int c = 0;
+
+        while (c < FRAME_MAX_COLS)
+        {
+            if (next[c] == shown[c])
+            {
+                c++;
+                continue;
+            }
+
+            int start = c;
+            int end = c + 1;
+
+            for (int j = end; j < FRAME_MAX_COLS && j - end < MERGE_GAP; j++)
+            {
+                if (next[j] != shown[j])
+                {
+                    end = j + 1;
+                }
+            }
+
+            if (length + ESCAPE_SPACE + (end - start) >= FRAME_OUTPUT_SIZE - ESCAPE_SPACE)
+            {
+                return -1;
+            }
+
+            length = AppendCursorMove(frame, length, r, start);
+            length = AppendText(frame, length, next + start, end - start);
+            c = end;
+        }
+    }
+
+    length = AppendCursorMove(frame, length, frame.numRows, 0);
+    return AppendText(frame, length, "\x1b[J", 3);                      // Clear whatever was printed under the last frame
+}
+
+void InitializeFrame(FrameBuffer& frame)
+{
+    memset(frame.shown, ' ', sizeof(frame.shown));
+    frame.shownRows = 0;
+    frame.isShownValid = false;
+
+    BeginFrame(frame);
+}
+
+void InvalidateFrame(FrameBuffer& frame)
+{
+    frame.isShownValid = false;
+}
+
+void BeginFrame(FrameBuffer& frame)
+{
+    memset(frame.cells, ' ', sizeof(frame.cells));
+    frame.numRows = 0;
+    frame.cursorRow = 0;
+    frame.cursorCol = 0;
+}
+
+void FrameWriteChar(FrameBuffer& frame, char c)
+{
+    if (c == '\n')
+    {
+        frame.cursorRow++;
+        frame.cursorCol = 0;
+        return;
+    }
+
+    if (frame.cursorRow < FRAME_MAX_ROWS && frame.cursorCol < FRAME_MAX_COLS)   // Anything past the grid is dropped
+    {
+        frame.cells[frame.cursorRow][frame.cursorCol] = c;
+
+        if (frame.cursorRow >= frame.numRows)
+        {
+            frame.numRows = frame.cursorRow + 1;
+        }
+    }
+
+    frame.cursorCol++;
+}
+
+void FrameWrite(FrameBuffer& frame, const char* text)
+{
+    for (; *text != '\0'; text++)
+    {
+        FrameWriteChar(frame, *text);
+    }
+}
+
+void FrameWriteInt(FrameBuffer& frame, int value)
+{
+    char text[16];
+
+    snprintf(text, sizeof(text), "%d", value);
+    FrameWrite(frame, text);
+}
+
+void PresentFrame(FrameBuffer& frame)
+{
+    bool useAnsi = GetTerminalMode() == TM_ANSI;
+    int length = -1;
+
+    if (useAnsi && frame.isShownValid && frame.numRows == frame.shownRows)
+    {
+        length = BuildFrameDiff(frame);
+    }
+
+    if (!useAnsi)
+    {
+        TerminalClearScreen();                                          // Whatever clearing the terminal mode offers, if any
+    }
+
+    if (length < 0)
+    {
+        length = BuildFullFrame(frame, useAnsi);
+    }
+
+    WriteToTerminal(frame.output, length);
+
+    memcpy(frame.shown, frame.cells, sizeof(frame.shown));
+    frame.shownRows = frame.numRows;
+    frame.isShownValid = true;
+}
+
+void PrintFrame(FrameBuffer& frame)
+{
+    WriteToTerminal(frame.output, BuildFullFrame(frame, false));
+
+    frame.isShownValid = false;                                         // The screen no longer matches the last presented frame
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef __RENDERER_H__
+#define __RENDERER_H__
+
+/*
+    Buffered frame renderer. A frame is drawn into a character grid with FrameWrite*, then
+    PresentFrame compares it with what is already on the screen and sends only the changed cells,
+    using ANSI cursor addressing, in a single write. The first frame (and any frame after
+    InvalidateFrame) clears the screen and is sent whole. Terminals without ANSI support (see
+    Terminal.h) get every frame whole, as plain text.
+*/
+
+enum
+{
+    FRAME_MAX_ROWS = 32,
+    FRAME_MAX_COLS = 96,
+    FRAME_OUTPUT_SIZE = FRAME_MAX_ROWS * FRAME_MAX_COLS * 4             // Escapes plus text, always enough for a full redraw
+};
+
+struct FrameBuffer
+{
+    char cells[FRAME_MAX_ROWS][FRAME_MAX_COLS];                         // The frame being drawn
+    char shown[FRAME_MAX_ROWS][FRAME_MAX_COLS];                         // What the terminal shows right now
+    int numRows;                                                        // Rows used by the frame being drawn
+    int shownRows;
+    int cursorRow;
+    int cursorCol;
+    bool isShownValid;                                                  // False until a full frame is on the screen
+    char output[FRAME_OUTPUT_SIZE];
+};
+
+void InitializeFrame(FrameBuffer& frame);
+void InvalidateFrame(FrameBuffer& frame);                               // Something else drew on the screen, redraw everything next time
+
+void BeginFrame(FrameBuffer& frame);
+void FrameWrite(FrameBuffer& frame, const char* text);                  // '\n' moves to the start of the next row
+void FrameWriteChar(FrameBuffer& frame, char c);
+void FrameWriteInt(FrameBuffer& frame, int value);
+void PresentFrame(FrameBuffer& frame);
+void PrintFrame(FrameBuffer& frame);                                    // The whole frame as plain lines where the cursor is, for reports
+
+#endif
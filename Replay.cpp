@@ -0,0 +1,118 @@
+// Replay.cpp : Logged games played back shot by shot, with checkpoints for seeking.
+//
+
+#include "Replay.h"
+
+bool FindGameRecord(const MappedFile& log, long long index, GameRecordView& record)
+{
+    int numBlocks = GetGameLogBlockCount(log.data, log.size);
+    GameLogReader reader;
+
+    if (numBlocks < 0 || index < 0)
+    {
+        return false;
+    }
+
+    InitializeGameLogReader(reader, log.data, 0, numBlocks);
+
+    while (NextGameRecord(reader, record))
+    {
+        if (index-- == 0)
+        {
+            return IsValidGameRecord(record);                           // StepReplay and the checkpoints rely on it
+        }
+    }
+    return false;
+}
+
+void StartReplay(GameRecordView record, GameSnapshot& snapshot)
+{
+    static const char* playerNames[2] = { "Player1", "Player2" };
+
+    for (int p = 0; p < 2; p++)
+    {
+        Player& player = snapshot.players[p];
+
+        InitializePlayer(player, playerNames[p]);
+
+        player.playerType = PT_AI;
+        player.aiStrategy = GetRecordStrategy(record, p);
+
+        ClearBoards(player);
+
+        for (int i = 0; i < NUM_SHIPS; i++)
+        {
+            int cell = GetRecordShipCell(record, p, i);
+            ShipPositionType position;
+
+            position.row = cell / BOARD_SIZE;
+            position.col = cell % BOARD_SIZE;
+
+            PlaceShipOnBoard(player, player.ships[i], position, GetRecordShipOrientation(record, p, i));
+        }
+    }
+
+    snapshot.turn = 0;
+    snapshot.currentPlayer = 0;
+    SeedRandom(snapshot.random, GetRecordSeed(record));
+}
+
+bool StepReplay(GameRecordView record, GameSnapshot& snapshot)
+{
+    if (snapshot.turn >= GetRecordShotCount(record))
+    {
+        return false;
+    }
+
+    int cell = GetRecordShotCell(record, snapshot.turn);
+    ShipPositionType guess;
+
+    guess.row = cell / BOARD_SIZE;
+    guess.col = cell % BOARD_SIZE;
+
+    UpdateBoards(guess, snapshot.players[snapshot.currentPlayer], snapshot.players[1 - snapshot.currentPlayer]);
+
+    snapshot.turn++;
+    snapshot.currentPlayer = 1 - snapshot.currentPlayer;
+
+    return true;
+}
+
+void BuildReplayTimeline(GameRecordView record, ReplayTimeline& timeline)
+{
+    GameSnapshot snapshot;
+
+    timeline.record = record;
+    timeline.numCheckpoints = 0;
+
+    StartReplay(record, snapshot);
+
+    do
+    {
+        if (snapshot.turn % REPLAY_CHECKPOINT_INTERVAL == 0 && timeline.numCheckpoints < MAX_REPLAY_CHECKPOINTS)
+        {
+            timeline.checkpoints[timeline.numCheckpoints++] = snapshot;
+        }
+
+    } while (StepReplay(record, snapshot));
+}
+
+void SeekReplay(const ReplayTimeline& timeline, int turn, GameSnapshot& snapshot)
+{
+    int checkpoint = turn / REPLAY_CHECKPOINT_INTERVAL;
+
+    if (checkpoint >= timeline.numCheckpoints)
+    {
+        checkpoint = timeline.numCheckpoints - 1;
+    }
+    if (checkpoint < 0)
+    {
+        checkpoint = 0;
+    }
+
+    snapshot = timeline.checkpoints[checkpoint];
+
+    while (snapshot.turn < turn && StepReplay(timeline.record, snapshot))
+    {
+    }
+}
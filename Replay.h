@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include "GameLog.h"
+#include "Snapshot.h"
+
+/*
+    Replays a logged game through UpdateBoards, with no AI and no drawing. Building a timeline
+    plays the game once and keeps a snapshot every REPLAY_CHECKPOINT_INTERVAL turns; seeking to
+    turn K then restores the nearest checkpoint at or before K and applies the few shots after it.
+    The AIs are not run, so a replayed snapshot's generator is seeded from the game's seed rather
+    than holding the state the live game had at that turn.
+*/
+
+enum
+{
+    REPLAY_CHECKPOINT_INTERVAL = 16,
+    MAX_REPLAY_CHECKPOINTS = MAX_GAME_TURNS / REPLAY_CHECKPOINT_INTERVAL + 1
+};
+
+struct ReplayTimeline
+{
+    GameRecordView record;
+    GameSnapshot checkpoints[MAX_REPLAY_CHECKPOINTS];                   // checkpoints[i] is the game after i * REPLAY_CHECKPOINT_INTERVAL turns
+    int numCheckpoints;
+};
+
+bool FindGameRecord(const MappedFile& log, long long index, GameRecordView& record);   // The index-th game of the log, from 0; false if missing or damaged
+void StartReplay(GameRecordView record, GameSnapshot& snapshot);        // Fleets placed, no shots fired
+bool StepReplay(GameRecordView record, GameSnapshot& snapshot);         // Applies the next shot, false once the game is over
+void BuildReplayTimeline(GameRecordView record, ReplayTimeline& timeline);
+void SeekReplay(const ReplayTimeline& timeline, int turn, GameSnapshot& snapshot);   // Past the last turn gives the final position
+
+#endif
@@ -0,0 +1,766 @@
+// Server.cpp : Many concurrent games over TCP on one epoll loop, and a loopback load test.
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include "Server.h"
+#include "Referee.h"
+#include "Bot.h"
+#include "Strategy.h"
+#include "Input.h"
+#include "Random.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#endif
+
+using namespace std;
+
+enum
+{
+    SESSION_OUTPUT_SIZE = 512,                                          // Room for a few answers, a client that does not read is dropped
+    MAX_EVENTS = 256,                                                   // Per epoll_wait
+    IDLE_WAIT_MILLISECONDS = 1000,                                      // Longest epoll_wait, so StopServer is noticed without the eventfd too
+    CONNECT_BATCH_SIZE = 256,                                           // Load test connections opened between passes over the events
+    CONNECT_BATCH_WAIT_MILLISECONDS = 1
+};
+
+enum SessionStateType
+{
+    SS_HANDSHAKE = 0,                                                   // Waiting for ready
+    SS_PLACING,                                                         // Waiting for the client's fleet
+    SS_SHOOTING                                                         // Waiting for the client's shot
+};
+
+struct alignas(CACHE_LINE_SIZE) ServerSession                           // Fills whole cache lines of its pool slot
+{
+    int fd;
+    SessionStateType state;
+    long long deadline;                                                 // Milliseconds on GetServerClock
+    long long gamesPlayed;
+    ServerSession* previous;                                            // Deadline list
+    ServerSession* next;
+    Player client;                                                      // The client's fleet and shots, as the server keeps them
+    Player ai;
+    int inputBytes;
+    int outputStart;
+    int outputEnd;
+    bool isWaitingToWrite;                                              // EPOLLOUT is on
+    char input[MAX_PROTOCOL_LINE];
+    char output[SESSION_OUTPUT_SIZE];
+};
+
+void PrintServerStats(const ServerStats& stats)
+{
+    cout << "Sessions:       " << stats.sessionsAccepted << " accepted, " << stats.sessionsRefused << " refused, " << stats.peakSessions << " at once" << endl;
+    cout << "Games played:   " << stats.gamesPlayed << ", " << stats.clientWins << " won by clients, " << stats.forfeits << " lost by forfeit" << endl;
+    cout << "Timeouts:       " << stats.timeouts << endl;
+    cout << "Shots:          " << stats.shots;
+
+    if (stats.elapsedSeconds > 0)
+    {
+        cout << " (" << stats.shots / stats.elapsedSeconds << " shots/sec)";
+    }
+
+    cout << endl;
+}
+
+void PrintLoadTestReport(const LoadTestReport& report)
+{
+    cout << "Clients:        " << report.clients << ", " << report.completedClients << " completed, " << report.failedClients << " failed" << endl;
+    cout << "Games played:   " << report.gamesPlayed << ", " << report.wins << " won by the clients" << endl;
+    cout << "Messages:       " << report.messages << endl;
+    cout << "Elapsed:        " << report.elapsedSeconds << " s";
+
+    if (report.elapsedSeconds > 0)
+    {
+        cout << " (" << report.gamesPlayed / report.elapsedSeconds << " games/sec, " << report.messages / report.elapsedSeconds << " messages/sec)";
+    }
+
+    cout << endl;
+}
+
+#ifndef __linux__
+
+bool StartServer(GameServer& server, const ServerConfig& config)
+{
+    server.config = config;
+    memset(&server.stats, 0, sizeof(server.stats));
+
+    cout << "The server needs epoll, it is only available on Linux" << endl;
+    return false;
+}
+
+void RunServer(GameServer&)
+{
+}
+
+void StopServer(GameServer& server)
+{
+    server.isStopping = true;
+}
+
+void CloseServer(GameServer&)
+{
+}
+
+bool RunServerLoadTest(int, int numClients, int, AIStrategyType, unsigned int, LoadTestReport& report)
+{
+    memset(&report, 0, sizeof(report));
+    report.clients = numClients;
+
+    cout << "The load test needs epoll, it is only available on Linux" << endl;
+    return false;
+}
+
+#else
+
+static long long GetServerClock()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void RaiseFileLimit()                                            // Every session is a descriptor, the soft limit is often 1024
+{
+    struct rlimit limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+/*
+    Lines come in pieces and several to a packet. Each complete line is handed to handleLine with
+    the '\r' of a telnet client cut off; the rest waits in input for more data. Returns false if
+    the connection is gone or a line does not fit.
+*/
+template<typename LineHandlerType>
+static bool ReceiveLines(int fd, char input[], int& inputBytes, LineHandlerType handleLine)
+{
+    for (;;)
+    {
+        ssize_t count = read(fd, input + inputBytes, size_t(MAX_PROTOCOL_LINE - inputBytes));
+
+        if (count == 0)
+        {
+            return false;
+        }
+        if (count < 0)
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+
+        int end = inputBytes + int(count);
+        int start = 0;
+
+        for (int i = inputBytes; i < end; i++)
+        {
+            if (input[i] != '\n')
+            {
+                continue;
+            }
+
+            input[i] = '\0';
+
+            if (i > start && input[i - 1] == '\r')
+            {
+                input[i - 1] = '\0';
+            }
+            if (!handleLine(input + start))
+            {
+                return false;
+            }
+            start = i + 1;
+        }
+
+        inputBytes = end - start;
+
+        if (inputBytes == MAX_PROTOCOL_LINE)
+        {
+            return false;                                               // No newline in a whole buffer
+        }
+
+        memmove(input, input + start, size_t(inputBytes));
+    }
+}
+
+/* Server sessions */
+
+static void WatchSession(GameServer& server, ServerSession& session, bool isWaitingToWrite)
+{
+    struct epoll_event event;
+
+    event.events = EPOLLIN;
+
+    if (isWaitingToWrite)
+    {
+        event.events |= EPOLLOUT;
+    }
+    event.data.ptr = &session;
+
+    epoll_ctl(server.epollFd, EPOLL_CTL_MOD, session.fd, &event);
+    session.isWaitingToWrite = isWaitingToWrite;
+}
+
+static void UnlinkSession(GameServer& server, ServerSession& session)
+{
+    (session.previous != nullptr ? session.previous->next : server.oldestSession) = session.next;
+    (session.next != nullptr ? session.next->previous : server.newestSession) = session.previous;
+    session.previous = nullptr;
+    session.next = nullptr;
+}
+
+static void LinkSession(GameServer& server, ServerSession& session)     // At the back, every deadline is now plus the same limit
+{
+    session.previous = server.newestSession;
+    session.next = nullptr;
+    (server.newestSession != nullptr ? server.newestSession->next : server.oldestSession) = &session;
+    server.newestSession = &session;
+}
+
+static void CloseSession(GameServer& server, ServerSession* session)
+{
+    UnlinkSession(server, *session);
+    close(session->fd);                                                 // Also takes it out of the epoll set
+    server.numSessions--;
+
+    ReleaseSessionSlot(server.sessionPool, session);
+}
+
+static bool FlushSession(GameServer& server, ServerSession& session)
+{
+    while (session.outputStart < session.outputEnd)
+    {
+        ssize_t count = send(session.fd, session.output + session.outputStart, size_t(session.outputEnd - session.outputStart), MSG_NOSIGNAL);
+
+        if (count < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                if (!session.isWaitingToWrite)
+                {
+                    WatchSession(server, session, true);
+                }
+                return true;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        session.outputStart += int(count);
+    }
+
+    session.outputStart = 0;
+    session.outputEnd = 0;
+
+    if (session.isWaitingToWrite)
+    {
+        WatchSession(server, session, false);
+    }
+    return true;
+}
+
+static bool QueueLine(ServerSession& session, const char* line)         // Sent by FlushSession once the input has been handled
+{
+    int length = int(strlen(line));
+
+    if (session.outputStart > 0)
+    {
+        memmove(session.output, session.output + session.outputStart, size_t(session.outputEnd - session.outputStart));
+        session.outputEnd -= session.outputStart;
+        session.outputStart = 0;
+    }
+    if (session.outputEnd + length + 1 > SESSION_OUTPUT_SIZE)
+    {
+        return false;
+    }
+
+    memcpy(session.output + session.outputEnd, line, size_t(length));
+    session.output[session.outputEnd + length] = '\n';
+    session.outputEnd += length + 1;
+
+    return true;
+}
+
+static bool SendRequest(GameServer& server, ServerSession& session, const char* request)   // A message that needs an answer, which restarts the clock
+{
+    session.deadline = GetServerClock() + server.config.moveMilliseconds;
+
+    UnlinkSession(server, session);
+    LinkSession(server, session);
+
+    return QueueLine(session, request);
+}
+
+static bool StartSessionGame(GameServer& server, ServerSession& session)
+{
+    ClearBoards(session.client);
+    ClearBoards(session.ai);
+    GetStrategy(session.ai.aiStrategy).PlaceFleet(session.ai);
+
+    session.state = SS_PLACING;
+    return SendRequest(server, session, "place");
+}
+
+static bool EndSessionGame(GameServer& server, ServerSession& session, bool hasClientWon, bool isForfeit)
+{
+    server.stats.gamesPlayed++;
+    server.stats.clientWins += hasClientWon ? 1 : 0;
+    server.stats.forfeits += isForfeit ? 1 : 0;
+    session.gamesPlayed++;
+
+    return QueueLine(session, hasClientWon ? "end win" : "end loss") && StartSessionGame(server, session);
+}
+
+static bool PlayServerShot(GameServer& server, ServerSession& session)  // The AI's turn, then the client's unless the game is over
+{
+    const Strategy& strategy = GetStrategy(session.ai.aiStrategy);
+    ShipPositionType guess;
+    char cell[4];
+    char message[MAX_PROTOCOL_LINE];
+
+    do
+    {
+        guess = strategy.ChooseShot(session.ai);
+
+    } while (GetGuessAt(session.ai, guess.row, guess.col) != GT_NONE);
+
+    UpdateBoards(guess, session.ai, session.client);
+    server.stats.shots++;
+
+    FormatProtocolCell(guess.row, guess.col, cell);
+    snprintf(message, sizeof(message), "incoming %s", cell);
+
+    if (!QueueLine(session, message))
+    {
+        return false;
+    }
+    if (AreAllShipsSunk(session.client))
+    {
+        return EndSessionGame(server, session, false, false);
+    }
+
+    session.state = SS_SHOOTING;
+    return SendRequest(server, session, "shoot");
+}
+
+static bool HandleSessionLine(GameServer& server, ServerSession& session, const char* line)   // False closes the session
+{
+    if (strcmp(line, "quit") == 0)
+    {
+        return false;
+    }
+
+    if (session.state == SS_HANDSHAKE)
+    {
+        return strncmp(line, "ready", 5) == 0 && StartSessionGame(server, session);
+    }
+
+    if (session.state == SS_PLACING)
+    {
+        if (!ParseProtocolFleet(line, session.client))
+        {
+            return EndSessionGame(server, session, false, true);
+        }
+        if (session.gamesPlayed & 1)
+        {
+            return PlayServerShot(server, session);
+        }
+
+        session.state = SS_SHOOTING;
+        return SendRequest(server, session, "shoot");
+    }
+
+    MoveInput move;
+
+    if (ParseMove(line, BOARD_SIZE, BOARD_SIZE, move) != MP_CELL || GetGuessAt(session.client, move.row, move.col) != GT_NONE)
+    {
+        return EndSessionGame(server, session, false, true);
+    }
+
+    ShipPositionType guess;
+    char message[MAX_PROTOCOL_LINE];
+
+    guess.row = move.row;
+    guess.col = move.col;
+
+    ShipType type = ResolveShot(guess, session.client, session.ai);
+
+    server.stats.shots++;
+    FormatShotResult(session.ai, type, message, sizeof(message));
+
+    if (!QueueLine(session, message))
+    {
+        return false;
+    }
+    if (AreAllShipsSunk(session.ai))
+    {
+        return EndSessionGame(server, session, true, false);
+    }
+    return PlayServerShot(server, session);
+}
+
+static void AcceptSessions(GameServer& server)
+{
+    for (;;)
+    {
+        int fd = accept4(server.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return;                                                     // EAGAIN once the backlog is empty, or out of descriptors
+        }
+
+        ServerSession* session = (ServerSession*)AcquireSessionSlot(server.sessionPool);
+
+        if (session == nullptr)                                         // maxSessions are open
+        {
+            server.stats.sessionsRefused++;
+            close(fd);
+            continue;
+        }
+
+        int noDelay = 1;
+
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));   // Every message is a short line waiting on an answer
+
+        struct epoll_event event;
+        char hello[MAX_PROTOCOL_LINE];
+
+        session->fd = fd;
+        session->state = SS_HANDSHAKE;
+        session->gamesPlayed = 0;
+        session->previous = nullptr;
+        session->next = nullptr;
+        session->inputBytes = 0;
+        session->outputStart = 0;
+        session->outputEnd = 0;
+        session->isWaitingToWrite = false;
+
+        InitializePlayer(session->client, "Client");
+        InitializePlayer(session->ai, GetAIStrategyName(server.config.strategy));
+        session->client.playerType = PT_HUMAN;
+        session->ai.playerType = PT_AI;
+        session->ai.aiStrategy = server.config.strategy;
+
+        event.events = EPOLLIN;
+        event.data.ptr = session;
+        epoll_ctl(server.epollFd, EPOLL_CTL_ADD, fd, &event);
+
+        LinkSession(server, *session);
+        server.numSessions++;
+        server.stats.sessionsAccepted++;
+
+        if (server.numSessions > server.stats.peakSessions)
+        {
+            server.stats.peakSessions = server.numSessions;
+        }
+
+        snprintf(hello, sizeof(hello), "battleship %d", PROTOCOL_VERSION);
+
+        if (!SendRequest(server, *session, hello) || !FlushSession(server, *session))
+        {
+            CloseSession(server, session);
+        }
+    }
+}
+
+static void ServeSession(GameServer& server, ServerSession* session, unsigned int events)
+{
+    bool isOpen = (events & (EPOLLERR | EPOLLHUP)) == 0;
+
+    if (isOpen && (events & EPOLLIN))
+    {
+        isOpen = ReceiveLines(session->fd, session->input, session->inputBytes, [&](const char* line)
+        {
+            return HandleSessionLine(server, *session, line);
+        });
+    }
+    if (isOpen)
+    {
+        isOpen = FlushSession(server, *session);                        // Whatever the lines queued, or the rest of an earlier answer
+    }
+    if (!isOpen)
+    {
+        CloseSession(server, session);
+    }
+}
+
+bool StartServer(GameServer& server, const ServerConfig& config)
+{
+    server.config = config;
+    memset(&server.stats, 0, sizeof(server.stats));
+    server.port = 0;
+    server.numSessions = 0;
+    server.oldestSession = nullptr;
+    server.newestSession = nullptr;
+    server.isStopping = false;
+    server.sessionPool.memory = nullptr;
+    server.sessionPool.nextFree = nullptr;
+
+    RaiseFileLimit();
+
+    server.listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    server.epollFd = epoll_create1(EPOLL_CLOEXEC);
+    server.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    struct sockaddr_in address;
+    socklen_t addressSize = sizeof(address);
+    int reuse = 1;
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)config.port);
+    address.sin_addr.s_addr = htonl(config.isLoopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+
+    if (server.listenFd < 0 || server.epollFd < 0 || server.wakeFd < 0 || !CreateSessionPool(server.sessionPool, sizeof(ServerSession), config.maxSessions) ||
+        setsockopt(server.listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(server.listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(server.listenFd, SOMAXCONN) != 0 ||
+        getsockname(server.listenFd, (struct sockaddr*)&address, &addressSize) != 0)
+    {
+        CloseServer(server);
+        return false;
+    }
+
+    server.port = ntohs(address.sin_port);
+
+    struct epoll_event event;
+
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;                                           // The listening socket
+    epoll_ctl(server.epollFd, EPOLL_CTL_ADD, server.listenFd, &event);
+
+    event.data.ptr = &server;                                           // The wake-up eventfd
+    epoll_ctl(server.epollFd, EPOLL_CTL_ADD, server.wakeFd, &event);
+
+    return true;
+}
+
+void RunServer(GameServer& server)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    struct epoll_event events[MAX_EVENTS];
+
+    SeedThreadRandom(server.config.seed);
+
+    while (!server.isStopping)
+    {
+        long long now = GetServerClock();
+        long long wait = IDLE_WAIT_MILLISECONDS;
+
+        if (server.oldestSession != nullptr && server.oldestSession->deadline - now < wait)
+        {
+            wait = server.oldestSession->deadline > now ? server.oldestSession->deadline - now : 0;
+        }
+
+        int numEvents = epoll_wait(server.epollFd, events, MAX_EVENTS, int(wait));
+
+        for (int i = 0; i < numEvents; i++)
+        {
+            if (events[i].data.ptr == nullptr)
+            {
+                AcceptSessions(server);
+            }
+            else if (events[i].data.ptr != &server)
+            {
+                ServeSession(server, (ServerSession*)events[i].data.ptr, events[i].events);
+            }
+        }
+
+        now = GetServerClock();
+
+        while (server.oldestSession != nullptr && server.oldestSession->deadline <= now)
+        {
+            server.stats.timeouts++;
+            CloseSession(server, server.oldestSession);
+        }
+    }
+
+    server.stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void StopServer(GameServer& server)
+{
+    uint64_t one = 1;
+
+    server.isStopping = true;
+
+    if (server.wakeFd >= 0 && write(server.wakeFd, &one, sizeof(one)) < 0)
+    {
+        return;                                                         // Already signalled, epoll_wait is returning anyway
+    }
+}
+
+void CloseServer(GameServer& server)
+{
+    while (server.oldestSession != nullptr)
+    {
+        CloseSession(server, server.oldestSession);
+    }
+
+    DestroySessionPool(server.sessionPool);
+
+    int* fds[3] = { &server.listenFd, &server.epollFd, &server.wakeFd };
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (*fds[i] >= 0)
+        {
+            close(*fds[i]);
+            *fds[i] = -1;
+        }
+    }
+}
+
+/* Load test clients */
+
+struct LoadTestClient
+{
+    int fd;
+    int gamesLeft;
+    int inputBytes;
+    BotEngine bot;
+    char input[MAX_PROTOCOL_LINE];
+};
+
+static bool SendClientLine(LoadTestClient& client, const char* line)    // Answers are a line at a time, the socket buffer always has room
+{
+    char buffer[MAX_PROTOCOL_LINE + 1];
+    int length = snprintf(buffer, sizeof(buffer), "%s\n", line);
+
+    return send(client.fd, buffer, size_t(length), MSG_NOSIGNAL) == length;
+}
+
+static bool HandleClientLine(LoadTestClient& client, LoadTestReport& report, const char* line)   // False once the client is done
+{
+    char answer[MAX_PROTOCOL_LINE];
+
+    report.messages++;
+
+    if (strncmp(line, "end ", 4) == 0)
+    {
+        report.gamesPlayed++;
+        report.wins += strcmp(line + 4, "win") == 0 ? 1 : 0;
+
+        if (--client.gamesLeft == 0)
+        {
+            SendClientLine(client, "quit");
+            report.completedClients++;
+            return false;
+        }
+    }
+
+    if (AnswerReferee(client.bot, line, answer, sizeof(answer)) == BA_ANSWER)
+    {
+        return SendClientLine(client, answer);
+    }
+    return true;
+}
+
+bool RunServerLoadTest(int port, int numClients, int gamesPerClient, AIStrategyType strategy, unsigned int seed, LoadTestReport& report)
+{
+    memset(&report, 0, sizeof(report));
+    report.clients = numClients;
+
+    RaiseFileLimit();
+    SeedThreadRandom(seed);
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (epollFd < 0)
+    {
+        return false;
+    }
+
+    vector<LoadTestClient> clients(numClients);
+    struct sockaddr_in address;
+    int numOpen = 0;
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    struct epoll_event events[MAX_EVENTS];
+    int nextClient = 0;
+
+    while (numOpen > 0 || nextClient < numClients)
+    {
+        int endClient = nextClient + CONNECT_BATCH_SIZE < numClients ? nextClient + CONNECT_BATCH_SIZE : numClients;
+
+        for (; nextClient < endClient; nextClient++)                    // The server speaks first, so a connect only has to be waited for by reading
+        {
+            LoadTestClient& client = clients[nextClient];
+            struct epoll_event event;
+
+            client.gamesLeft = gamesPerClient;
+            client.inputBytes = 0;
+            InitializeBotEngine(client.bot, strategy);
+
+            client.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (client.fd < 0 || (connect(client.fd, (struct sockaddr*)&address, sizeof(address)) != 0 && errno != EINPROGRESS))
+            {
+                if (client.fd >= 0)
+                {
+                    close(client.fd);
+                }
+                client.fd = -1;
+                report.failedClients++;
+                continue;
+            }
+
+            event.events = EPOLLIN;
+            event.data.ptr = &client;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+            numOpen++;
+        }
+
+        int wait = nextClient < numClients ? CONNECT_BATCH_WAIT_MILLISECONDS : -1;   // Let the server accept the batch before it overflows the backlog
+        int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, wait);
+
+        for (int i = 0; i < numEvents; i++)
+        {
+            LoadTestClient& client = *(LoadTestClient*)events[i].data.ptr;
+            bool isDone = false;
+            bool isOpen = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0 && ReceiveLines(client.fd, client.input, client.inputBytes, [&](const char* line)
+            {
+                isDone = !HandleClientLine(client, report, line);
+                return !isDone;
+            });
+
+            if (!isOpen)
+            {
+                report.failedClients += isDone ? 0 : 1;
+                close(client.fd);
+                client.fd = -1;
+                numOpen--;
+            }
+        }
+    }
+
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    close(epollFd);
+    return report.failedClients == 0;
+}
+
+#endif
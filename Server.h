@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef __SERVER_H__
+#define __SERVER_H__
+
+#include <atomic>
+#include "Game.h"
+#include "SessionPool.h"
+
+/*
+    Game server: thousands of matches over TCP on one thread. Every connection is a session with
+    its own Player pair, the client's fleet against the server's AI, and the server plays referee
+    to the client with the same line protocol as --referee (see Referee.h): it sends battleship 1,
+    place, shoot, result, incoming and end, and the client answers ready, its fleet and its shots.
+    Games follow one another until the client sends quit or hangs up; the client fires first in
+    even games and the AI in odd ones.
+
+    Sockets are non-blocking and served by one epoll loop, so a session costs its buffers and two
+    Players, not a thread. Sessions live in slots of a SessionPool sized for maxSessions, so once
+    the server is up, connections and games come and go without touching the heap.
+
+    Every request carries a deadline of the move time limit. Sessions sit on a list in deadline
+    order (a request always moves its session to the back), so timeouts are found at the front of
+    the list without a scan. An illegal answer loses the game, a timeout closes the session.
+
+    RunServerLoadTest is the client side: it opens many connections from one epoll loop and plays
+    each of them with a built-in AI, so the whole server can be driven over loopback. epoll makes
+    this Linux only.
+*/
+
+struct ServerSession;
+
+struct ServerConfig
+{
+    int port;                                                           // 0 picks a free one, see GameServer::port
+    bool isLoopbackOnly;
+    int maxSessions;                                                    // Connections beyond this are closed straight away
+    int moveMilliseconds;                                               // Time the client has for each answer
+    AIStrategyType strategy;                                            // The server's side of every game
+    unsigned int seed;
+};
+
+struct ServerStats
+{
+    long long sessionsAccepted;
+    long long sessionsRefused;                                          // Over maxSessions
+    long long peakSessions;
+    long long gamesPlayed;
+    long long clientWins;
+    long long forfeits;                                                 // Games the client lost to an illegal answer
+    long long timeouts;                                                 // Sessions closed for a late answer
+    long long shots;                                                    // By both sides
+    double elapsedSeconds;
+};
+
+struct GameServer
+{
+    ServerConfig config;
+    ServerStats stats;
+    int port;                                                           // The one actually bound
+    int listenFd;
+    int epollFd;
+    int wakeFd;                                                         // eventfd that breaks RunServer out of epoll_wait
+    int numSessions;
+    SessionPool sessionPool;                                            // maxSessions slots, taken by accept and given back on close
+    ServerSession* oldestSession;                                       // Deadline order, the first to time out
+    ServerSession* newestSession;
+    std::atomic<bool> isStopping;
+};
+
+struct LoadTestReport
+{
+    int clients;
+    int completedClients;                                               // Played all their games and quit
+    int failedClients;                                                  // Could not connect, or the server hung up
+    long long gamesPlayed;
+    long long wins;                                                     // Games the clients won
+    long long messages;                                                 // Lines received from the server
+    double elapsedSeconds;
+};
+
+bool StartServer(GameServer& server, const ServerConfig& config);       // Binds and listens, false if it cannot
+void RunServer(GameServer& server);                                     // Serves until StopServer
+void StopServer(GameServer& server);                                    // From any thread, or a signal handler
+void CloseServer(GameServer& server);                                   // Closes the sessions that are left
+void PrintServerStats(const ServerStats& stats);
+
+bool RunServerLoadTest(int port, int numClients, int gamesPerClient, AIStrategyType strategy, unsigned int seed, LoadTestReport& report);
+void PrintLoadTestReport(const LoadTestReport& report);
+
+#endif
@@ -0,0 +1,79 @@
+// SessionPool.cpp : Preallocated cache-line-aligned session slots behind a lock-free free list.
+//
+
+#include <new>
+#include "SessionPool.h"
+
+using namespace std;
+
+static const uint64_t INDEX_MASK = 0xFFFFFFFFull;
+static const uint64_t CHANGE_COUNT_ONE = 1ull << 32;
+
+bool CreateSessionPool(SessionPool& pool, size_t slotSize, int numSlots)
+{
+    pool.slotSize = (slotSize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    pool.numSlots = numSlots;
+    pool.memory = new (nothrow) unsigned char[pool.slotSize * numSlots + CACHE_LINE_SIZE];
+    pool.nextFree = new (nothrow) atomic<uint32_t>[numSlots];
+
+    if (pool.memory == nullptr || pool.nextFree == nullptr)
+    {
+        DestroySessionPool(pool);
+        return false;
+    }
+
+    pool.slab = pool.memory + (CACHE_LINE_SIZE - uintptr_t(pool.memory) % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+
+    for (int i = 0; i < numSlots; i++)                                  // Slot i + 1 follows slot i, the last one ends the list
+    {
+        pool.nextFree[i].store(i + 1 < numSlots ? uint32_t(i + 2) : 0, memory_order_relaxed);
+    }
+
+    pool.freeHead.store(numSlots > 0 ? 1 : 0, memory_order_release);
+    return true;
+}
+
+void DestroySessionPool(SessionPool& pool)
+{
+    delete[] pool.memory;
+    delete[] pool.nextFree;
+
+    pool.memory = nullptr;
+    pool.slab = nullptr;
+    pool.nextFree = nullptr;
+    pool.numSlots = 0;
+}
+
+void* AcquireSessionSlot(SessionPool& pool)
+{
+    uint64_t head = pool.freeHead.load(memory_order_acquire);
+
+    for (;;)
+    {
+        uint32_t index = uint32_t(head & INDEX_MASK);
+
+        if (index == 0)
+        {
+            return nullptr;
+        }
+
+        uint64_t next = pool.nextFree[index - 1].load(memory_order_relaxed);  // May be stale if the slot was just taken, the CAS then fails
+
+        if (pool.freeHead.compare_exchange_weak(head, ((head & ~INDEX_MASK) + CHANGE_COUNT_ONE) | next, memory_order_acquire, memory_order_acquire))
+        {
+            return pool.slab + size_t(index - 1) * pool.slotSize;
+        }
+    }
+}
+
+void ReleaseSessionSlot(SessionPool& pool, void* slot)
+{
+    uint32_t index = uint32_t(((unsigned char*)slot - pool.slab) / pool.slotSize) + 1;
+    uint64_t head = pool.freeHead.load(memory_order_relaxed);
+
+    do
+    {
+        pool.nextFree[index - 1].store(uint32_t(head & INDEX_MASK), memory_order_relaxed);
+
+    } while (!pool.freeHead.compare_exchange_weak(head, ((head & ~INDEX_MASK) + CHANGE_COUNT_ONE) | index, memory_order_release, memory_order_relaxed));
+}
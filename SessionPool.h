@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef __SESSIONPOOL_H__
+#define __SESSIONPOOL_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+    Fixed-size slots for game sessions, carved out of one slab allocated up front. Every slot starts
+    on a cache line and is a whole number of lines long, so two threads working on neighbouring
+    slots never share a line. Free slots are kept on a lock-free stack: acquiring and releasing is
+    one compare-and-swap, with no allocation and no lock once the pool exists.
+
+    The stack head packs the index of the top slot with a counter that every change bumps, so a
+    slot that is taken and given back between another thread's read and its compare-and-swap
+    cannot be mistaken for an unchanged head (the ABA problem).
+
+    A slot comes back with whatever the last user left in it; the caller resets what it needs,
+    ClearBoards for the Players.
+*/
+
+enum
+{
+    CACHE_LINE_SIZE = 64
+};
+
+struct SessionPool
+{
+    unsigned char* memory;                                              // As allocated, slab is this rounded up to a cache line
+    unsigned char* slab;
+    std::atomic<uint32_t>* nextFree;                                    // Per slot, the next free slot's index + 1, 0 for none
+    size_t slotSize;                                                    // Rounded up to whole cache lines
+    int numSlots;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> freeHead;            // Top free slot's index + 1 | change count << 32, on a line of its own
+};
+
+bool CreateSessionPool(SessionPool& pool, size_t slotSize, int numSlots);   // False if the slab cannot be allocated
+void DestroySessionPool(SessionPool& pool);                             // Every slot must have been released
+
+void* AcquireSessionSlot(SessionPool& pool);                            // Null once every slot is in use
+void ReleaseSessionSlot(SessionPool& pool, void* slot);
+
+#endif
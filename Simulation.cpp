@@ -0,0 +1,230 @@
+// Simulation.cpp : Headless AI-vs-AI games for batch runs.
+//
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include "Simulation.h"
+#include "Random.h"
+#include "GameLog.h"
+#include "Strategy.h"
+#include "Profiler.h"
+
+using namespace std;
+
+/*
+    One game between two strategies fixed at compile time. Every hook is called on the strategy
+    type itself, so the shot loop has no virtual calls or strategy switches and the simple hooks
+    inline away. SimulateGame picks the instantiation for the two strategies once per game.
+*/
+
+template<typename StrategyType>
+static inline bool PlayShot(Player& currentPlayer, Player& otherPlayer, int current, GameResult& result, GameRecord* record)
+{
+    ShipPositionType guess;
+    int retries = -1;
+
+    do
+    {
+        guess = StrategyType::ChooseShot(currentPlayer);
+        retries++;
+
+    } while (GetGuessAt(currentPlayer, guess.row, guess.col) != GT_NONE);
+
+    PROFILE_VALUE(PP_GUESS_RETRIES, retries);
+
+    ShipType type = ResolveShot(guess, currentPlayer, otherPlayer);
+
+    NotifyShot(StrategyType(), currentPlayer, otherPlayer, guess, type);
+
+    result.shots[current]++;
+
+    if (record != nullptr)
+    {
+        RecordShot(*record, guess, type != ST_NONE);
+    }
+
+    if (type != ST_NONE)
+    {
+        result.hits[current]++;
+    }
+
+    result.turns++;
+
+    return AreAllShipsSunk(otherPlayer);
+}
+
+template<typename StrategyTypeA, typename StrategyTypeB>
+static GameResult SimulateMatch(unsigned int seed, GameRecord* record)
+{
+    SeedThreadRandom(seed);                                             // Per-thread generator, so games can run on any thread
+
+    Player players[2];
+
+    InitializePlayer(players[0], "Player1");
+    InitializePlayer(players[1], "Player2");
+
+    players[0].playerType = PT_AI;
+    players[0].aiStrategy = StrategyTypeA::TYPE;
+    players[1].playerType = PT_AI;
+    players[1].aiStrategy = StrategyTypeB::TYPE;
+
+    ClearBoards(players[0]);
+    StrategyTypeA::PlaceFleet(players[0]);
+    ClearBoards(players[1]);
+    StrategyTypeB::PlaceFleet(players[1]);
+
+    if (record != nullptr)
+    {
+        record->seed = seed;
+        record->strategies[0] = (unsigned char)StrategyTypeA::TYPE;
+        record->strategies[1] = (unsigned char)StrategyTypeB::TYPE;
+        record->numShots = 0;
+
+        RecordFleet(*record, 0, players[0]);
+        RecordFleet(*record, 1, players[1]);
+    }
+
+    GameResult result = {};
+
+    for (;;)                                                            // Player1 always fires first
+    {
+        if (PlayShot<StrategyTypeA>(players[0], players[1], 0, result, record))
+        {
+            result.winner = 0;
+            break;
+        }
+        if (PlayShot<StrategyTypeB>(players[1], players[0], 1, result, record))
+        {
+            result.winner = 1;
+            break;
+        }
+    }
+
+    if (record != nullptr)
+    {
+        record->winner = (unsigned char)result.winner;
+    }
+
+    return result;
+}
+
+typedef GameResult (*SimulateMatchFunction)(unsigned int seed, GameRecord* record);
+
+template<typename StrategyTypeA>
+struct MatchTableRow                                                    // SimulateMatch<StrategyTypeA, B> for every B, in AIStrategyType order
+{
+    static const SimulateMatchFunction functions[NUM_AI_STRATEGIES];
+};
+
+template<typename StrategyTypeA>
+const SimulateMatchFunction MatchTableRow<StrategyTypeA>::functions[NUM_AI_STRATEGIES] =
+{
+    SimulateMatch<StrategyTypeA, RandomStrategy>,
+    SimulateMatch<StrategyTypeA, DensityStrategy>,
+    SimulateMatch<StrategyTypeA, MonteCarloStrategy>,
+    SimulateMatch<StrategyTypeA, EndgameStrategy>,
+    SimulateMatch<StrategyTypeA, ParityStrategy>
+};
+
+static const SimulateMatchFunction* const matchTable[NUM_AI_STRATEGIES] =   // Indexed by Player1's AIStrategyType
+{
+    MatchTableRow<RandomStrategy>::functions,
+    MatchTableRow<DensityStrategy>::functions,
+    MatchTableRow<MonteCarloStrategy>::functions,
+    MatchTableRow<EndgameStrategy>::functions,
+    MatchTableRow<ParityStrategy>::functions
+};
+
+GameResult SimulateGame(AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, GameRecord* record)
+{
+    if (strategyA < 0 || strategyA >= NUM_AI_STRATEGIES)
+    {
+        strategyA = AI_RANDOM;
+    }
+    if (strategyB < 0 || strategyB >= NUM_AI_STRATEGIES)
+    {
+        strategyB = AI_RANDOM;
+    }
+
+    return matchTable[strategyA][strategyB](seed, record);
+}
+
+void RunSimulations(int numGames, AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, GameLogFile* log, SimulationStats& stats)
+{
+    static GameLogWriter writer;                                        // 16 KB block buffer, kept out of the stack
+    GameRecord record;
+
+    if (log != nullptr)
+    {
+        InitializeGameLogWriter(writer, *log);
+    }
+
+    stats.gamesPlayed = 0;
+    stats.wins[0] = 0;
+    stats.wins[1] = 0;
+    stats.totalTurns = 0;
+    stats.minTurns = MAX_GAME_TURNS;
+    stats.maxTurns = 0;
+    stats.logFailed = false;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int i = 0; i < numGames; i++)
+    {
+        bool isRecording = log != nullptr && !stats.logFailed;
+        GameResult result = SimulateGame(strategyA, strategyB, seed + i, isRecording ? &record : nullptr);   // Game i can be reproduced on its own from seed + i
+
+        if (isRecording && !AppendGameRecord(writer, record))
+        {
+            stats.logFailed = true;                                     // Keep playing, the log just stops here
+        }
+
+        stats.gamesPlayed++;
+        stats.wins[result.winner]++;
+        stats.totalTurns += result.turns;
+
+        if (result.turns < stats.minTurns)
+        {
+            stats.minTurns = result.turns;
+        }
+        if (result.turns > stats.maxTurns)
+        {
+            stats.maxTurns = result.turns;
+        }
+    }
+
+    if (log != nullptr && !FlushGameLogWriter(writer))
+    {
+        stats.logFailed = true;
+    }
+
+    stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void PrintSimulationStats(const SimulationStats& stats)
+{
+    if (stats.gamesPlayed == 0)
+    {
+        cout << "No games were played." << endl;
+        return;
+    }
+
+    cout << "Games played:   " << stats.gamesPlayed << endl;
+    cout << "Player1 wins:   " << stats.wins[0] << " (" << 100.0 * stats.wins[0] / stats.gamesPlayed << "%)" << endl;
+    cout << "Player2 wins:   " << stats.wins[1] << " (" << 100.0 * stats.wins[1] / stats.gamesPlayed << "%)" << endl;
+    cout << "Turns per game: avg " << double(stats.totalTurns) / stats.gamesPlayed << ", min " << stats.minTurns << ", max " << stats.maxTurns << endl;
+    cout << "Elapsed:        " << stats.elapsedSeconds << " s";
+
+    if (stats.elapsedSeconds > 0)
+    {
+        cout << " (" << stats.gamesPlayed / stats.elapsedSeconds << " games/sec)";
+    }
+
+    cout << endl;
+
+    if (stats.logFailed)
+    {
+        cout << "Game log:       write failed, stopped recording" << endl;
+    }
+}
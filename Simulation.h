@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+#include "Game.h"
+
+/*
+    Headless AI-vs-AI games. Nothing in here draws, clears the screen or waits for input,
+    so games can be run back to back as fast as the board functions allow.
+*/
+
+enum
+{
+    MAX_GAME_TURNS = 2 * BOARD_SIZE * BOARD_SIZE                        // Both players guessing every cell
+};
+
+struct SimulationStats
+{
+    int gamesPlayed;
+    int wins[2];
+    long long totalTurns;
+    int minTurns;
+    int maxTurns;
+    double elapsedSeconds;
+    bool logFailed;                                                     // A log write failed, the games after it were not recorded
+};
+
+struct GameRecord;
+struct GameLogFile;
+
+GameResult SimulateGame(AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, GameRecord* record);    // record may be null
+void RunSimulations(int numGames, AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, GameLogFile* log, SimulationStats& stats);
+void PrintSimulationStats(const SimulationStats& stats);
+
+#endif
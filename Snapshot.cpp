@@ -0,0 +1,87 @@
+// Snapshot.cpp : Flat copies of a game in progress, in memory and on disk.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include "Snapshot.h"
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "Snapshots are taken with plain copies");
+
+struct SnapshotFileHeader
+{
+    char magic[4];
+    unsigned int snapshotSize;                                          // Catches files from builds with a different layout
+};
+
+static const char SNAPSHOT_MAGIC[4] = { 'B', 'S', 'S', 'N' };
+
+static FILE* OpenSnapshotFile(const char* path, const char* mode)
+{
+    FILE* file = nullptr;
+
+#ifdef _WIN32
+    if (fopen_s(&file, path, mode) != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(path, mode);
+#endif
+    return file;
+}
+
+void TakeSnapshot(GameSnapshot& snapshot, const Player& player1, const Player& player2, int turn, int currentPlayer)
+{
+    snapshot.players[0] = player1;
+    snapshot.players[1] = player2;
+    snapshot.turn = turn;
+    snapshot.currentPlayer = currentPlayer;
+    snapshot.random = GetThreadRandom();
+}
+
+void RestoreSnapshot(const GameSnapshot& snapshot, Player& player1, Player& player2)
+{
+    player1 = snapshot.players[0];
+    player2 = snapshot.players[1];
+    GetThreadRandom() = snapshot.random;
+}
+
+bool SaveSnapshot(const GameSnapshot& snapshot, const char* path)
+{
+    FILE* file = OpenSnapshotFile(path, "wb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    SnapshotFileHeader header;
+
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.snapshotSize = sizeof(GameSnapshot);
+
+    bool isSaved = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(&snapshot, sizeof(snapshot), 1, file) == 1;
+
+    fclose(file);
+    return isSaved;
+}
+
+bool LoadSnapshot(GameSnapshot& snapshot, const char* path)
+{
+    FILE* file = OpenSnapshotFile(path, "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    SnapshotFileHeader header;
+    bool isLoaded = fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+        && header.snapshotSize == sizeof(GameSnapshot)
+        && fread(&snapshot, sizeof(snapshot), 1, file) == 1;
+
+    fclose(file);
+    return isLoaded;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "Game.h"
+#include "Random.h"
+
+/*
+    A game in progress as one flat struct: both players, whose turn it is and the generator the
+    game draws from. Player holds no pointers, so taking or restoring a snapshot is a plain copy and
+    a snapshot can be written to disk as it is. Snapshot files are only meant to be read back by
+    the same build.
+*/
+
+struct GameSnapshot
+{
+    Player players[2];
+    int turn;                                                           // Shots fired so far, both players together
+    int currentPlayer;                                                  // Index into players of the one to move
+    RandomState random;
+};
+
+void TakeSnapshot(GameSnapshot& snapshot, const Player& player1, const Player& player2, int turn, int currentPlayer);
+void RestoreSnapshot(const GameSnapshot& snapshot, Player& player1, Player& player2);   // Also restores the thread's generator
+
+bool SaveSnapshot(const GameSnapshot& snapshot, const char* path);
+bool LoadSnapshot(GameSnapshot& snapshot, const char* path);            // False if missing or written by a different build
+
+#endif
@@ -0,0 +1,28 @@
+// Strategy.cpp : The runtime table of AI strategies.
+//
+
+#include "Strategy.h"
+
+static StrategyAdapter<RandomStrategy> randomStrategy;
+static StrategyAdapter<DensityStrategy> densityStrategy;
+static StrategyAdapter<MonteCarloStrategy> monteCarloStrategy;
+static StrategyAdapter<EndgameStrategy> endgameStrategy;
+static StrategyAdapter<ParityStrategy> parityStrategy;
+
+static const Strategy* const strategies[NUM_AI_STRATEGIES] =           // Indexed by AIStrategyType
+{
+    &randomStrategy,
+    &densityStrategy,
+    &monteCarloStrategy,
+    &endgameStrategy,
+    &parityStrategy
+};
+
+const Strategy& GetStrategy(AIStrategyType strategy)
+{
+    if (strategy < 0 || strategy >= NUM_AI_STRATEGIES)
+    {
+        return randomStrategy;
+    }
+    return *strategies[strategy];
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#ifndef __STRATEGY_H__
+#define __STRATEGY_H__
+
+#include "Game.h"
+#include "DensityAI.h"
+#include "MonteCarloAI.h"
+#include "EndgameSolver.h"
+#include "ParityAI.h"
+
+/*
+    AI strategies as a set of hooks: what to forget when a new game starts, where to place the
+    fleet, where to fire next, and what to do when a shot misses, hits or sinks a ship. Everything
+    a strategy remembers lives in Player, so the hooks are static and players stay flat copies.
+    The hooks only run for PT_AI players, ClearBoards and UpdateBoards both check.
+
+    There are two ways to call them. Each strategy is a struct of static functions, so a template
+    such as SimulateMatch<DensityStrategy, RandomStrategy> in Simulation.cpp calls them directly
+    and the compiler can inline the whole game. For a strategy picked at runtime, GetStrategy
+    returns the same hooks behind the virtual Strategy interface, which is what the console game
+    and UpdateBoards use.
+
+    A new strategy derives from StrategyDefaults, defines TYPE, ChooseShot and any other hooks it
+    needs, and is added to the AIStrategyType enum and the tables in Strategy.cpp and
+    Simulation.cpp.
+*/
+
+struct Strategy                                                         // Runtime interface, one instance per AIStrategyType
+{
+    virtual ~Strategy() {}
+
+    virtual void ResetState(Player& player) const = 0;                  // From ClearBoards, once the boards are cleared
+    virtual void PlaceFleet(Player& player) const = 0;                  // Ships go on a cleared board
+    virtual ShipPositionType ChooseShot(const Player& player) const = 0;   // May return a guessed cell, the caller asks again
+    virtual void OnMiss(Player& player, int cell) const = 0;
+    virtual void OnHit(Player& player, int cell) const = 0;             // Every hit, including the one that sinks
+    virtual void OnSunk(Player& player, const BoardMask& shipCells, int shipSize) const = 0;
+};
+
+struct StrategyDefaults                                                 // Hooks a strategy gets unless it hides them with its own
+{
+    static void ResetState(Player&)
+    {
+    }
+
+    static void PlaceFleet(Player& player)
+    {
+        SetupAIBoards(player);
+    }
+
+    static void OnMiss(Player&, int)
+    {
+    }
+
+    static void OnHit(Player&, int)
+    {
+    }
+
+    static void OnSunk(Player&, const BoardMask&, int)
+    {
+    }
+};
+
+struct RandomStrategy : StrategyDefaults
+{
+    static const AIStrategyType TYPE = AI_RANDOM;
+
+    static void ResetState(Player& player)
+    {
+        ResetShotPool(player.shotPool);
+    }
+
+    static ShipPositionType ChooseShot(const Player& player)
+    {
+        return DrawFromShotPool(player.shotPool);
+    }
+
+    static void OnMiss(Player& player, int cell)
+    {
+        RemoveFromShotPool(player.shotPool, cell);
+    }
+
+    static void OnHit(Player& player, int cell)
+    {
+        RemoveFromShotPool(player.shotPool, cell);
+    }
+};
+
+struct DensityStrategy : StrategyDefaults
+{
+    static const AIStrategyType TYPE = AI_DENSITY;
+
+    static void ResetState(Player& player)
+    {
+        ResetDensityState(player);
+    }
+
+    static ShipPositionType ChooseShot(const Player& player)
+    {
+        return GetDensityGuess(player);
+    }
+
+    static void OnMiss(Player& player, int cell)
+    {
+        UpdateDensityOnMiss(player.densityState, cell);
+    }
+
+    static void OnSunk(Player& player, const BoardMask& shipCells, int shipSize)
+    {
+        UpdateDensityOnSunk(player.densityState, shipCells, shipSize);
+    }
+};
+
+struct MonteCarloStrategy : StrategyDefaults
+{
+    static const AIStrategyType TYPE = AI_MONTE_CARLO;
+
+    static ShipPositionType ChooseShot(const Player& player)
+    {
+        return GetMonteCarloGuess(player);
+    }
+};
+
+struct EndgameStrategy : DensityStrategy                                // Keeps the density counts for the shots the solver passes on
+{
+    static const AIStrategyType TYPE = AI_ENDGAME;
+
+    static ShipPositionType ChooseShot(const Player& player)
+    {
+        ShipPositionType guess;
+
+        if (SolveEndgame(player, guess))
+        {
+            return guess;
+        }
+        return GetDensityGuess(player);
+    }
+};
+
+struct ParityStrategy : StrategyDefaults
+{
+    static const AIStrategyType TYPE = AI_PARITY;
+
+    static void ResetState(Player& player)
+    {
+        ResetParityState(player);
+    }
+
+    static ShipPositionType ChooseShot(const Player& player)
+    {
+        return GetParityGuess(player);
+    }
+
+    static void OnMiss(Player& player, int cell)
+    {
+        UpdateParityOnMiss(player.parityState, cell);
+    }
+
+    static void OnHit(Player& player, int cell)
+    {
+        UpdateParityOnHit(player.parityState, player, cell);
+    }
+
+    static void OnSunk(Player& player, const BoardMask& shipCells, int shipSize)
+    {
+        UpdateParityOnSunk(player.parityState, player, shipCells, shipSize);
+    }
+};
+
+template<typename StrategyType>
+struct StrategyAdapter final : Strategy                                 // The static hooks of StrategyType behind the virtual interface
+{
+    void ResetState(Player& player) const override
+    {
+        StrategyType::ResetState(player);
+    }
+
+    void PlaceFleet(Player& player) const override
+    {
+        StrategyType::PlaceFleet(player);
+    }
+
+    ShipPositionType ChooseShot(const Player& player) const override
+    {
+        return StrategyType::ChooseShot(player);
+    }
+
+    void OnMiss(Player& player, int cell) const override
+    {
+        StrategyType::OnMiss(player, cell);
+    }
+
+    void OnHit(Player& player, int cell) const override
+    {
+        StrategyType::OnHit(player, cell);
+    }
+
+    void OnSunk(Player& player, const BoardMask& shipCells, int shipSize) const override
+    {
+        StrategyType::OnSunk(player, shipCells, shipSize);
+    }
+};
+
+const Strategy& GetStrategy(AIStrategyType strategy);                   // Unknown values get the random strategy
+
+/*
+    Tells the shooter's strategy what its shot did, type being what ResolveShot returned. hooks is
+    either a strategy struct, whose static hooks are then called directly, or a Strategy from
+    GetStrategy, which goes through the virtual interface.
+*/
+
+template<typename HooksType>
+inline void NotifyShot(const HooksType& hooks, Player& currentPlayer, const Player& otherPlayer, ShipPositionType guess, ShipType type)
+{
+    int cell = CellIndex(guess.row, guess.col);
+
+    if (type == ST_NONE)
+    {
+        hooks.OnMiss(currentPlayer, cell);
+        return;
+    }
+
+    const Ship& ship = otherPlayer.ships[type - 1];
+
+    hooks.OnHit(currentPlayer, cell);
+
+    if (IsSunk(otherPlayer, ship))
+    {
+        hooks.OnSunk(currentPlayer, otherPlayer.shipMasks[type - 1], ship.shipSize);
+    }
+}
+
+#endif
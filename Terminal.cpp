@@ -0,0 +1,193 @@
+// Terminal.cpp : Screen clearing and single key reads without shelling out.
+//
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Terminal.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <conio.h>
+#include <io.h>
+#define isatty _isatty
+#else
+#include <unistd.h>
+#include <termios.h>
+#endif
+
+using namespace std;
+
+static TerminalModeType terminalMode = TM_AUTO;
+
+static bool EnableAnsiOutput()                                          // Windows 10 consoles need VT processing switched on
+{
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+
+    if (console == INVALID_HANDLE_VALUE || !GetConsoleMode(console, &mode))
+    {
+        return false;
+    }
+    return SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+#else
+    const char* term = getenv("TERM");
+
+    return term == nullptr || strcmp(term, "dumb") != 0;
+#endif
+}
+
+static TerminalModeType DetectTerminalMode()
+{
+    if (!isatty(0) || !isatty(1))
+    {
+        return TM_PLAIN;
+    }
+
+    if (EnableAnsiOutput())
+    {
+        return TM_ANSI;
+    }
+
+#ifdef _WIN32
+    return TM_SYSTEM;                                                   // Legacy console, cls still works
+#else
+    return TM_PLAIN;
+#endif
+}
+
+static void WriteSequence(const char* sequence)
+{
+    cout << sequence;
+    cout.flush();
+}
+
+void SetTerminalMode(TerminalModeType mode)
+{
+    if (mode == TM_AUTO)
+    {
+        mode = DetectTerminalMode();
+    }
+    else if (mode == TM_ANSI)
+    {
+        EnableAnsiOutput();
+    }
+
+    terminalMode = mode;
+}
+
+TerminalModeType GetTerminalMode()
+{
+    if (terminalMode == TM_AUTO)
+    {
+        SetTerminalMode(TM_AUTO);
+    }
+    return terminalMode;
+}
+
+const char* GetTerminalModeName(TerminalModeType mode)
+{
+    switch (mode)
+    {
+    case TM_ANSI:
+        return "ansi";
+    case TM_SYSTEM:
+        return "system";
+    case TM_PLAIN:
+        return "plain";
+    default:
+        return "auto";
+    }
+}
+
+bool ParseTerminalMode(const char* name, TerminalModeType& mode)
+{
+    for (int i = TM_AUTO; i <= TM_PLAIN; i++)
+    {
+        if (strcmp(name, GetTerminalModeName(TerminalModeType(i))) == 0)
+        {
+            mode = TerminalModeType(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TerminalClearScreen()
+{
+    switch (GetTerminalMode())
+    {
+    case TM_ANSI:
+        WriteSequence("\x1b[H\x1b[2J");
+        break;
+    case TM_SYSTEM:
+#ifdef _WIN32
+        system("cls");
+#else
+        system("clear");
+#endif
+        break;
+    default:
+        break;
+    }
+}
+
+int TerminalReadKey()
+{
+    cout.flush();
+
+#ifdef _WIN32
+    return _getch();
+#else
+    termios original;
+
+    if (tcgetattr(0, &original) != 0)                                   // Not a terminal, fall back to a plain read
+    {
+        int c = getchar();
+        return c == EOF ? -1 : c;
+    }
+
+    termios raw = original;
+
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+
+    tcsetattr(0, TCSANOW, &raw);
+
+    unsigned char c;
+    ssize_t count = read(0, &c, 1);
+
+    tcsetattr(0, TCSANOW, &original);
+
+    return count == 1 ? c : -1;
+#endif
+}
+
+void TerminalWaitForKey(const char* prompt)
+{
+    switch (GetTerminalMode())
+    {
+    case TM_ANSI:
+        if (isatty(0))                                                  // Piped input is all game moves, never eat one
+        {
+            cout << prompt;
+            TerminalReadKey();
+            cout << endl;
+        }
+        break;
+    case TM_SYSTEM:
+#ifdef _WIN32
+        system("pause");
+#else
+        system("read -n 1 -s -p \"Press any key to continue...\";echo");
+#endif
+        break;
+    default:
+        break;                                                          // Scripted input: don't eat a line meant for the game
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef __TERMINAL_H__
+#define __TERMINAL_H__
+
+/*
+    Portable terminal control. Clearing the screen and waiting for a key are done with escape
+    sequences and a single-keystroke read (termios raw mode on Linux/macOS, _getch on Windows),
+    so neither spawns a shell. The mode is picked at runtime; TM_AUTO looks at whether stdin/stdout
+    are a terminal that understands ANSI sequences.
+*/
+
+enum TerminalModeType
+{
+    TM_AUTO = 0,
+    TM_ANSI,                                                            // Escape sequences and raw key reads, no processes spawned
+    TM_SYSTEM,                                                          // The old system("cls")/system("pause") shell commands
+    TM_PLAIN                                                            // No clearing and no waiting, for pipes and log files
+};
+
+void SetTerminalMode(TerminalModeType mode);
+TerminalModeType GetTerminalMode();                                     // Never TM_AUTO, auto is resolved on first use
+const char* GetTerminalModeName(TerminalModeType mode);
+bool ParseTerminalMode(const char* name, TerminalModeType& mode);
+
+void TerminalClearScreen();
+void TerminalWaitForKey(const char* prompt);
+int TerminalReadKey();                                                  // One keystroke without waiting for Enter, -1 at end of input
+
+#endif
@@ -0,0 +1,269 @@
+// ThreadPool.cpp : Persistent worker threads running work-stealing ParallelFor jobs.
+//
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+#include "ThreadPool.h"
+
+using namespace std;
+
+struct alignas(64) WorkRange                                            // One cache line each so owners and thieves don't false share
+{
+    atomic<uint64_t> range;                                             // begin in the low 32 bits, end in the high 32 bits
+};
+
+struct ThreadPool
+{
+    vector<thread> threads;                                             // Workers 1..N-1, the caller of ParallelFor is worker 0
+    int numThreads = 1;
+
+    mutex ownerMutex;                                                   // Held by the thread currently running a ParallelFor
+    mutex stateMutex;
+    condition_variable wakeWorkers;
+    condition_variable workersDone;
+    uint64_t generation = 0;
+    int activeWorkers = 0;
+    bool shuttingDown = false;
+
+    ParallelTask task = nullptr;
+    void* context = nullptr;
+    int grainSize = 1;
+
+    ~ThreadPool();
+};
+
+static WorkRange workRanges[MAX_POOL_THREADS];
+static ThreadPool pool;
+static thread_local bool insideParallelFor = false;
+
+static uint64_t PackRange(uint32_t begin, uint32_t end)
+{
+    return uint64_t(begin) | (uint64_t(end) << 32);
+}
+
+static bool TakeLocalWork(int self, int& begin, int& end)
+{
+    atomic<uint64_t>& range = workRanges[self].range;
+    uint64_t current = range.load(memory_order_acquire);
+
+    for (;;)
+    {
+        uint32_t b = uint32_t(current);
+        uint32_t e = uint32_t(current >> 32);
+
+        if (b >= e)
+        {
+            return false;
+        }
+
+        uint32_t next = (e - b > uint32_t(pool.grainSize)) ? b + pool.grainSize : e;
+
+        if (range.compare_exchange_weak(current, PackRange(next, e), memory_order_acq_rel))
+        {
+            begin = int(b);
+            end = int(next);
+            return true;
+        }
+    }
+}
+
+static bool StealWork(int self)
+{
+    for (int k = 1; k < pool.numThreads; k++)
+    {
+        int victim = (self + k) % pool.numThreads;
+        atomic<uint64_t>& range = workRanges[victim].range;
+        uint64_t current = range.load(memory_order_acquire);
+
+        for (;;)
+        {
+            uint32_t b = uint32_t(current);
+            uint32_t e = uint32_t(current >> 32);
+
+            if (b >= e)
+            {
+                break;
+            }
+
+            uint32_t take = (e - b + 1) / 2;                            // Steal the back half, the owner keeps working on the front
+
+            if (range.compare_exchange_weak(current, PackRange(b, e - take), memory_order_acq_rel))
+            {
+                workRanges[self].range.store(PackRange(e - take, e), memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void RunWorker(int self)
+{
+    int begin;
+    int end;
+
+    for (;;)
+    {
+        if (TakeLocalWork(self, begin, end))
+        {
+            pool.task(self, begin, end, pool.context);
+        }
+        else if (!StealWork(self))                                      // Work is only ever split, so a full empty pass means we are done
+        {
+            return;
+        }
+    }
+}
+
+static void WorkerMain(int self)
+{
+    uint64_t seenGeneration = 0;
+
+    insideParallelFor = true;
+
+    for (;;)
+    {
+        unique_lock<mutex> lock(pool.stateMutex);
+
+        pool.wakeWorkers.wait(lock, [&] { return pool.shuttingDown || pool.generation != seenGeneration; });
+
+        if (pool.shuttingDown)
+        {
+            return;
+        }
+
+        seenGeneration = pool.generation;
+        lock.unlock();
+
+        RunWorker(self);
+
+        lock.lock();
+
+        if (--pool.activeWorkers == 0)
+        {
+            pool.workersDone.notify_one();
+        }
+    }
+}
+
+static void StopWorkers()
+{
+    {
+        lock_guard<mutex> lock(pool.stateMutex);
+        pool.shuttingDown = true;
+    }
+
+    pool.wakeWorkers.notify_all();
+
+    for (size_t i = 0; i < pool.threads.size(); i++)
+    {
+        pool.threads[i].join();
+    }
+
+    pool.threads.clear();
+    pool.shuttingDown = false;
+    pool.numThreads = 1;
+}
+
+ThreadPool::~ThreadPool()
+{
+    if (!threads.empty())
+    {
+        StopWorkers();
+    }
+}
+
+int GetHardwareThreadCount()
+{
+    unsigned int count = thread::hardware_concurrency();
+
+    return count > 0 ? int(count) : 1;
+}
+
+void SetThreadPoolSize(int numThreads)
+{
+    lock_guard<mutex> owner(pool.ownerMutex);
+
+    if (numThreads < 1)
+    {
+        numThreads = 1;
+    }
+    if (numThreads > MAX_POOL_THREADS)
+    {
+        numThreads = MAX_POOL_THREADS;
+    }
+    if (numThreads == pool.numThreads)
+    {
+        return;
+    }
+
+    StopWorkers();
+
+    pool.numThreads = numThreads;
+
+    for (int i = 1; i < numThreads; i++)
+    {
+        pool.threads.push_back(thread(WorkerMain, i));
+    }
+}
+
+int GetThreadPoolSize()
+{
+    return pool.numThreads;
+}
+
+int GetParallelWidth()
+{
+    return insideParallelFor ? 1 : pool.numThreads;
+}
+
+void ParallelFor(int count, int grainSize, ParallelTask task, void* context)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (insideParallelFor || pool.numThreads == 1 || !pool.ownerMutex.try_lock())
+    {
+        task(0, 0, count, context);                                     // Nested or single threaded, run everything here
+        return;
+    }
+
+    int numThreads = pool.numThreads;
+
+    pool.task = task;
+    pool.context = context;
+    pool.grainSize = grainSize > 0 ? grainSize : 1;
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        uint32_t begin = uint32_t((int64_t(count) * i) / numThreads);
+        uint32_t end = uint32_t((int64_t(count) * (i + 1)) / numThreads);
+
+        workRanges[i].range.store(PackRange(begin, end), memory_order_relaxed);
+    }
+
+    {
+        lock_guard<mutex> lock(pool.stateMutex);
+        pool.activeWorkers = numThreads - 1;
+        pool.generation++;
+    }
+
+    pool.wakeWorkers.notify_all();
+
+    insideParallelFor = true;
+    RunWorker(0);
+    insideParallelFor = false;
+
+    {
+        unique_lock<mutex> lock(pool.stateMutex);
+        pool.workersDone.wait(lock, [] { return pool.activeWorkers == 0; });
+    }
+
+    pool.ownerMutex.unlock();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+/*
+    Work-stealing parallel for. ParallelFor splits [0, count) evenly over the pool threads; each thread
+    takes grainSize items at a time from the front of its own range, and once that is empty steals
+    half of what is left at the back of another thread's range. Ranges are single 64-bit atomics, so
+    neither taking nor stealing work needs a lock.
+*/
+
+enum
+{
+    MAX_POOL_THREADS = 256
+};
+
+typedef void (*ParallelTask)(int threadIndex, int begin, int end, void* context);   // Handles items [begin, end)
+
+int GetHardwareThreadCount();
+void SetThreadPoolSize(int numThreads);                                  // 1 runs every task on the calling thread
+int GetThreadPoolSize();
+int GetParallelWidth();                                                 // Threads a ParallelFor from here would get, 1 when nested
+
+// threadIndex is in [0, GetThreadPoolSize()). A ParallelFor issued from inside another one runs
+// on the calling thread only, with threadIndex 0.
+void ParallelFor(int count, int grainSize, ParallelTask task, void* context);
+
+#endif
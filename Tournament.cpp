@@ -0,0 +1,182 @@
+// Tournament.cpp : Multithreaded batches of headless games.
+//
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include "Tournament.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+enum
+{
+    TOURNAMENT_GRAIN_SIZE = 64                                          // Games a thread takes from its own range at a time
+};
+
+struct alignas(64) TournamentThreadStats                                // Written by one thread only, merged after the run
+{
+    long long gamesPlayed;
+    long long wins[2];
+    long long totalTurns;
+    long long turnHistogram[MAX_VARIANT_TURNS + 1];
+    double busySeconds;
+};
+
+struct TournamentContext
+{
+    GameVariantType variant;
+    AIStrategyType strategyA;
+    AIStrategyType strategyB;
+    unsigned int seed;
+    GameLogWriter* writers;                                             // One per thread, null when not logging
+};
+
+static TournamentThreadStats threadStats[MAX_POOL_THREADS];             // Static storage keeps the 64 byte alignment
+
+static void PlayTournamentGames(int threadIndex, int begin, int end, void* context)
+{
+    const TournamentContext& tournament = *(const TournamentContext*)context;
+    TournamentThreadStats& stats = threadStats[threadIndex];
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int i = begin; i < end; i++)
+    {
+        GameResult result;
+
+        if (tournament.variant == GV_CLASSIC)
+        {
+            GameRecord record;
+            GameLogWriter* writer = tournament.writers != nullptr ? &tournament.writers[threadIndex] : nullptr;
+            bool isRecording = writer != nullptr && !writer->hasFailed;
+
+            result = SimulateGame(tournament.strategyA, tournament.strategyB, tournament.seed + i, isRecording ? &record : nullptr);
+
+            if (isRecording)
+            {
+                AppendGameRecord(*writer, record);                      // Failures stay on the writer and the log, RunTournament reports them
+            }
+        }
+        else
+        {
+            result = SimulateVariantGame(tournament.variant, tournament.seed + i);
+        }
+
+        stats.gamesPlayed++;
+        stats.wins[result.winner]++;
+        stats.totalTurns += result.turns;
+        stats.turnHistogram[result.turns]++;
+    }
+
+    stats.busySeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void RunTournament(int numGames, GameVariantType variant, AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, int numThreads, GameLogFile* log, TournamentReport& report)
+{
+    SetThreadPoolSize(numThreads);
+    numThreads = GetThreadPoolSize();
+
+    memset(threadStats, 0, sizeof(TournamentThreadStats) * numThreads);
+
+    vector<GameLogWriter> writers(log != nullptr && variant == GV_CLASSIC ? numThreads : 0);   // Allocated per run, not per game
+
+    for (size_t t = 0; t < writers.size(); t++)
+    {
+        InitializeGameLogWriter(writers[t], *log);
+    }
+
+    TournamentContext context = { variant, strategyA, strategyB, seed, writers.empty() ? nullptr : writers.data() };
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    ParallelFor(numGames, TOURNAMENT_GRAIN_SIZE, PlayTournamentGames, &context);
+
+    report.logFailed = false;
+
+    for (size_t t = 0; t < writers.size(); t++)
+    {
+        if (!FlushGameLogWriter(writers[t]))
+        {
+            report.logFailed = true;
+        }
+    }
+
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report.numThreads = numThreads;
+    report.gamesPlayed = 0;
+    report.wins[0] = 0;
+    report.wins[1] = 0;
+    report.totalTurns = 0;
+    memset(report.turnHistogram, 0, sizeof(report.turnHistogram));
+    report.threads.resize(numThreads);
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        const TournamentThreadStats& stats = threadStats[t];
+
+        report.gamesPlayed += stats.gamesPlayed;
+        report.wins[0] += stats.wins[0];
+        report.wins[1] += stats.wins[1];
+        report.totalTurns += stats.totalTurns;
+
+        for (int turns = 0; turns <= MAX_VARIANT_TURNS; turns++)
+        {
+            report.turnHistogram[turns] += stats.turnHistogram[turns];
+        }
+
+        report.threads[t].gamesPlayed = stats.gamesPlayed;
+        report.threads[t].busySeconds = stats.busySeconds;
+    }
+}
+
+void PrintTournamentReport(const TournamentReport& report)
+{
+    if (report.gamesPlayed == 0)
+    {
+        cout << "No games were played." << endl;
+        return;
+    }
+
+    double games = double(report.gamesPlayed);
+
+    cout << "Games played:   " << report.gamesPlayed << " on " << report.numThreads << " thread(s)" << endl;
+    cout << "Player1 wins:   " << report.wins[0] << " (" << 100.0 * report.wins[0] / games << "%)" << endl;
+    cout << "Player2 wins:   " << report.wins[1] << " (" << 100.0 * report.wins[1] / games << "%)" << endl;
+    cout << "Turns per game: avg " << report.totalTurns / games << endl;
+    cout << "Elapsed:        " << report.elapsedSeconds << " s (" << games / report.elapsedSeconds << " games/sec)" << endl;
+
+    if (report.logFailed)
+    {
+        cout << "Game log:       write failed, stopped recording" << endl;
+    }
+
+    cout << endl << "Thread\tGames\tGames/sec" << endl;
+
+    for (int t = 0; t < report.numThreads; t++)
+    {
+        const TournamentThreadSummary& thread = report.threads[t];
+        double rate = thread.busySeconds > 0 ? thread.gamesPlayed / thread.busySeconds : 0.0;
+
+        cout << "  " << t << "\t" << thread.gamesPlayed << "\t" << rate << endl;
+    }
+
+    cout << endl << "Game length (turns)" << endl;
+
+    const int BUCKET_WIDTH = 10;
+
+    for (int first = 0; first <= MAX_VARIANT_TURNS; first += BUCKET_WIDTH)
+    {
+        long long count = 0;
+
+        for (int turns = first; turns < first + BUCKET_WIDTH && turns <= MAX_VARIANT_TURNS; turns++)
+        {
+            count += report.turnHistogram[turns];
+        }
+
+        if (count > 0)
+        {
+            cout << "  " << first << "-" << first + BUCKET_WIDTH - 1 << "\t" << count << " (" << 100.0 * count / games << "%)" << endl;
+        }
+    }
+}
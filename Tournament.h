@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef __TOURNAMENT_H__
+#define __TOURNAMENT_H__
+
+#include <vector>
+#include "Simulation.h"
+#include "BoardGame.h"
+#include "GameLog.h"
+
+/*
+    Runs large numbers of headless games over the thread pool. Game i is always played with seed + i,
+    so a tournament gives the same totals whichever thread happens to play which game. The classic
+    variant plays the chosen AI strategies; the other variants are random-vs-random on their own
+    board and fleet.
+*/
+
+struct TournamentThreadSummary
+{
+    long long gamesPlayed;
+    double busySeconds;                                                 // Time spent inside games, excluding waiting for work
+};
+
+struct TournamentReport
+{
+    int numThreads;
+    long long gamesPlayed;
+    long long wins[2];
+    long long totalTurns;
+    long long turnHistogram[MAX_VARIANT_TURNS + 1];                     // Games that lasted exactly that many turns
+    double elapsedSeconds;
+    bool logFailed;                                                     // A log write failed, the games after it were not recorded
+    std::vector<TournamentThreadSummary> threads;
+};
+
+void RunTournament(int numGames, GameVariantType variant, AIStrategyType strategyA, AIStrategyType strategyB, unsigned int seed, int numThreads, GameLogFile* log, TournamentReport& report);   // log may be null, classic games only
+void PrintTournamentReport(const TournamentReport& report);
+
+#endif
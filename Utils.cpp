@@ -1,152 +1,154 @@
 #include "Utils.h"
+#include "Terminal.h"
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <cctype>
 
 using namespace std;
 
-char GetCharacter(const char* prompt, const char* error)
+static void ReadLine(const char* prompt, char line[])                  // Leaves the program once the input runs out, a prompt can't be answered then
 {
-    char input;
-    bool inputFailure;
+    cout << prompt << flush;
 
-    do {
+    if (!ReadInputLine(GetStandardInput(), line, MAX_INPUT_LINE))
+    {
+        cout << endl << "End of input." << endl;
+        exit(0);
+    }
+}
 
-        inputFailure = false;
-        cout << prompt;
+static char FirstCharacter(const char* line)
+{
+    while (*line == ' ' || *line == '\t')
+    {
+        line++;
+    }
+    return *line;
+}
 
-        cin >> input;
+char GetCharacter(const char* prompt, const char* error)
+{
+    char line[MAX_INPUT_LINE];
 
-        if (cin.fail())
+    for (;;)
+    {
+        ReadLine(prompt, line);
+
+        char input = FirstCharacter(line);
+
+        if (isalpha((unsigned char)input))
         {
-            cin.ignore(256, '\n');
-            cin.clear();
-            cout << error << endl;
-            inputFailure = true;
-        }
-        else
-        {
-            cin.ignore(256, '\n');
-            if (isalpha(input))
-            {
-                input = tolower(input);
-            }
-            else
-            {
-                cout << error << endl;
-                inputFailure = true;
-            }
+            return char(tolower((unsigned char)input));
         }
 
-    } while (inputFailure);
-
-    return input;
+        cout << error << endl;
+    }
 }
 
 
 char GetCharacter(const char* prompt, const char* error, const char validInput[], int validInputLength, CharacterCaseType charCase)
 {
-    const int IGNORE_CHARS = 256;
-
-    char input;
-    bool inputFailure = false;
+    char line[MAX_INPUT_LINE];
 
-    do {
+    for (;;)
+    {
+        ReadLine(prompt, line);
 
-        cout << prompt;
-        cin >> input;
+        char input = FirstCharacter(line);
 
-        if (cin.fail())
-        {
-            cin.ignore(IGNORE_CHARS, '\n');
-            cin.clear();
-            cout << error << endl;
-            inputFailure = true;
-        }
-        else
+        if (isalpha((unsigned char)input))
         {
-            cin.ignore(IGNORE_CHARS, '\n');
-
-            if (isalpha(input))
+            if (charCase == CC_UPPER_CASE)
             {
-                if (charCase == CC_UPPER_CASE)
-                {
-                    input = toupper(input);
-                }
-                else if (charCase == CC_LOWER_CASE)
-                {
-                    input = tolower(input);
-                }
+                input = char(toupper((unsigned char)input));
             }
-
-            for (int i = 0; i < validInputLength; ++i)
+            else if (charCase == CC_LOWER_CASE)
             {
-                if (input == validInput[i])
-                {
-                    return input;
-                }
+                input = char(tolower((unsigned char)input));
             }
-
-            cout << error << endl;
-            inputFailure = true;
         }
 
-    } while (inputFailure);
+        for (int i = 0; i < validInputLength; ++i)
+        {
+            if (input == validInput[i])
+            {
+                return input;
+            }
+        }
 
-    return ' ';
+        cout << error << endl;
+    }
 }
 
 int GetInteger(const char* prompt, const char* error, const int validInput[], int validInputlength)
 {
+    char line[MAX_INPUT_LINE];
 
-    const int IGNORE_CHARS = 256;
-
-    int input;
-    bool inputFailure;
-
-    do
+    for (;;)
     {
+        ReadLine(prompt, line);
 
-        inputFailure = false;
-        cout << prompt;
-        cin >> input;
+        char* end;
+        long input = strtol(line, &end, 10);
 
-        if (cin.fail())
-        {
-            cin.clear();
-            cin.ignore(IGNORE_CHARS, '\n');
-            cout << error << endl;
-            inputFailure = true;
-        }
-        else
+        if (end != line)
         {
             for (int i = 0; i < validInputlength; i++)
             {
                 if (input == validInput[i])
                 {
-                    return input;
+                    return int(input);
                 }
             }
-
-            cout << error << endl;
-            inputFailure = true;
         }
 
-    } while (inputFailure);
+        cout << error << endl;
+    }
+}
+
+bool GetMove(const char* prompt, const char* error, int numRows, int numCols, bool allowOrientation, MoveInput& move)
+{
+    char line[MAX_INPUT_LINE];
+
+    for (;;)
+    {
+        ReadLine(prompt, line);
+
+        MoveParseType type = ParseMove(line, numRows, numCols, move);
+
+        if (type == MP_ROW_ONLY)                                        // Row and column on separate lines, as the old prompts took them
+        {
+            char colPrompt[40];
+
+            snprintf(colPrompt, sizeof(colPrompt), "Please input a col(1-%d): ", numCols);
+            ReadLine(colPrompt, line);
 
-    return -1;
+            char* end;
+            long col = strtol(line, &end, 10);
 
+            if (end != line && col >= 1 && col <= numCols)
+            {
+                move.col = int(col - 1);
+                return false;
+            }
+        }
+        else if (type == MP_CELL || (type == MP_CELL_AND_ORIENTATION && allowOrientation))
+        {
+            return type == MP_CELL_AND_ORIENTATION;
+        }
+
+        cout << error << endl;
+    }
 }
 
 void ClearScreen()
 {
-    system("cls"); //for windows only!
-    //system("clear");
+    TerminalClearScreen(); // escape sequence, system("cls"/"clear") only in the "system" terminal mode
 }
 
 void WaitForKeyPress()
 {
-    system("pause"); //Windows only!
-
-    //system("read -n 1 -s -p \"Press any key to continue...\";echo");
+    TerminalWaitForKey("Press any key to continue . . . ");
 }
@@ -3,6 +3,8 @@
 #ifndef __UTILS_H__
 #define __UTILS_H__
 
+#include "Input.h"
+
 enum CharacterCaseType
 {
 	CC_UPPER_CASE = 0,
@@ -15,6 +17,14 @@ char GetCharacter(const char* prompt, const char* error);
 
 int GetInteger(const char* prompt, const char* error, const int validInput[], int validInputlength);
 
+/*
+    Reads a whole move such as "B7" or, with allowOrientation, "B7 H" from one line. A row letter
+    on its own gets a second prompt for the column. Returns true if an orientation was given.
+    Like the other prompts it repeats until the answer is valid, and ends the program at end of
+    input.
+*/
+bool GetMove(const char* prompt, const char* error, int numRows, int numCols, bool allowOrientation, MoveInput& move);
+
 void ClearScreen();
 
 void WaitForKeyPress();